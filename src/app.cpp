@@ -1,9 +1,13 @@
 #include "app.h"
 #include "appconfig.h"
 #include "engine/engine.h"
+#include "engine/framepacer.h"
+#include "engine/frameverifier.h"
+#include "engine/softwarerenderbackend.h"
 #include "app_state/game.h"
 #include "app_state/menu.h"
 
+#include <algorithm>
 #include <ctime>
 #include <iostream>
 #include <stdlib.h>
@@ -13,9 +17,17 @@
 
 #define VERSION "1.0.0"
 
+/**
+ * Longest sleep of the main thread while nothing is presented, in milliseconds; bounds the delay of noticing the end of the simulation
+ */
+static const int idle_wait_time = 100;
+
 App::App()
 {
     m_window = nullptr;
+    m_app_state = nullptr;
+    m_simulation_stats = PacerStats();
+    SDL_AtomicSet(&m_simulation_running, 0);
 }
 
 App::~App()
@@ -24,8 +36,15 @@ App::~App()
         delete m_app_state;
 }
 
-void App::run()
+int App::run()
 {
+    if(!AppConfig::replay_path.empty() && !m_replay.play(AppConfig::replay_path))
+    {
+        std::cerr << "Cannot play replay " << AppConfig::replay_path << std::endl;
+        return 1;
+    }
+    if(AppConfig::headless) return runHeadless();
+
     is_running = true;
     // Initialization of SDL and creation of the window
 
@@ -34,74 +53,305 @@ void App::run()
         m_window = SDL_CreateWindow("TANKS", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                     AppConfig::windows_rect.w, AppConfig::windows_rect.h, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
 
-        if(m_window == nullptr) return;
+        if(m_window == nullptr) return 1;
 
-        if(!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) return;
-        if(TTF_Init() == -1) return;
+        if(!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) return 1;
+        if(TTF_Init() == -1) return 1;
 
-        srand(time(NULL)); // Initializing the pseudorandom number generator
+        // Initializing the pseudorandom number generator; a replay repeats the game only with the recorded seed and tick duration
+        Uint32 seed = time(NULL);
+        if(m_replay.isPlaying())
+        {
+            seed = m_replay.seed();
+            AppConfig::simulation_tick_time = m_replay.tickTime();
+        }
+        else if(!AppConfig::record_path.empty() && !m_replay.record(AppConfig::record_path, seed, AppConfig::simulation_tick_time))
+            std::cerr << "Cannot record replay " << AppConfig::record_path << std::endl;
+        srand(seed);
 
         Engine& engine = Engine::getEngine();
         engine.initModules();
         engine.getRenderer()->loadTexture(m_window);
         engine.getRenderer()->loadFont();
 
-        m_app_state = new Menu;
+        FrameFormat capture_format;
+        if(!AppConfig::capture_path.empty())
+        {
+            if(!FrameWriter::parseFormat(AppConfig::capture_format, &capture_format))
+                std::cerr << "Unknown capture format: " << AppConfig::capture_format << std::endl;
+            else if(!engine.getRenderer()->startCapture(AppConfig::capture_path, capture_format))
+                std::cerr << "Cannot capture frames to " << AppConfig::capture_path << std::endl;
+        }
+
+        SDL_Thread* simulation = nullptr;
+        if(AppConfig::benchmark)
+        {
+            runBenchmark();
+            is_running = false;
+        }
+        else
+        {
+            m_app_state = new Menu;
+            SDL_AtomicSet(&m_simulation_running, 1);
+            simulation = SDL_CreateThread(simulationThread, "simulation", this);
+            if(simulation == nullptr) is_running = false;
+        }
+
+        // the main thread only handles window events and presents frames, so a slow present does not delay the simulation;
+        // when there is nothing to present it sleeps until an event arrives or the simulation publishes a frame
+        FramePacer present_pacer;
+        present_pacer.setFrameTime(AppConfig::present_frame_time);
+        while(is_running && SDL_AtomicGet(&m_simulation_running))
+        {
+            eventProces();
+
+            if(engine.getRenderer()->present())
+                present_pacer.wait(); // without a frame time the presentation is paced by vertical sync only
+            else
+                SDL_WaitEventTimeout(nullptr, idle_wait_time);
+        }
+
+        SDL_AtomicSet(&m_simulation_running, 0);
+        if(simulation != nullptr)
+            SDL_WaitThread(simulation, nullptr);
+        if(AppConfig::show_pacing_stats && simulation != nullptr)
+        {
+            printPacingStats("Simulation", m_simulation_stats);
+            printPacingStats("Presentation", present_pacer.stats());
+        }
+        engine.getRenderer()->stopCapture();
+
+        engine.destroyModules();
+    }
+
+    SDL_DestroyWindow(m_window);
+    m_window = nullptr;
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}
+
+int App::runHeadless()
+{
+    if(!m_replay.isPlaying())
+    {
+        std::cerr << "Headless mode requires --replay FILE" << std::endl;
+        return 1;
+    }
+    if(AppConfig::golden_path.empty())
+    {
+        std::cerr << "Headless mode requires --golden FILE" << std::endl;
+        return 1;
+    }
+    if(SDL_Init(0) != 0) return 1;
+
+    int result = 1;
+    if((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) && TTF_Init() == 0)
+    {
+        srand(m_replay.seed());
+        AppConfig::simulation_tick_time = m_replay.tickTime();
+
+        Engine& engine = Engine::getEngine();
+        engine.initModules();
+
+        SoftwareRenderBackend backend;
+        FrameVerifier verifier;
+        verifier.setUpdate(AppConfig::update_golden);
+        verifier.setImagesPath(AppConfig::golden_images_path);
+        verifier.setDiffPath(AppConfig::diff_path);
 
-        double FPS;
-        Uint32 time1, time2, dt, fps_time = 0, fps_count = 0, delay = 15;
-        time1 = SDL_GetTicks();
-        while(is_running)
+        bool loaded = backend.load();
+        if(!loaded)
+            std::cerr << "Cannot load textures and fonts" << std::endl;
+        else if(!AppConfig::update_golden && !verifier.load(AppConfig::golden_path))
         {
-            time2 = SDL_GetTicks();
-            dt = time2 - time1;
-            time1 = time2;
+            std::cerr << "Cannot read golden file " << AppConfig::golden_path << std::endl;
+            loaded = false;
+        }
 
-            if(m_app_state->finished())
+        if(loaded)
+        {
+            m_app_state = new Menu;
+            std::vector<SDL_Event> events;
+            unsigned step = std::max(AppConfig::verify_frame_step, 1u);
+            // time of the software backend alone, to keep an eye on its throughput
+            Uint64 render_time = 0;
+            unsigned rendered = 0;
+            // the replay drives the simulation as fast as possible, each checked frame is drawn at its final position
+            for(unsigned tick = 0; nextState() && m_replay.playTick(events); tick++)
             {
-                AppState* new_state = m_app_state->nextState();
-                delete m_app_state;
-                m_app_state = new_state;
-            }
-            if(m_app_state == nullptr) break;
+                engine.getInput()->setKeyboardState(m_replay.keyboardState());
+                for(SDL_Event& event : events)
+                    m_app_state->eventProcess(&event);
 
-            eventProces();
+                m_app_state->update(AppConfig::simulation_tick_time);
+                m_app_state->redraw();
 
-            m_app_state->update(dt);
-            m_app_state->draw();
+                const RenderCommandBuffer* frame = engine.getRenderer()->takeFrame();
+                if(frame == nullptr || tick % step != 0) continue;
+                Uint64 start = SDL_GetPerformanceCounter();
+                backend.execute(*frame, 1.0f);
+                render_time += SDL_GetPerformanceCounter() - start;
+                rendered++;
+                verifier.check(tick, backend.pixels(), backend.width(), backend.height());
+            }
 
-            SDL_Delay(delay);
+            if(render_time > 0)
+                std::cout << "Software backend: " << rendered << " frames, " << rendered * SDL_GetPerformanceFrequency() / render_time << " frames/s" << std::endl;
 
-            // FPS
-            fps_time += dt; fps_count++;
-            if(fps_time > 200)
+            if(AppConfig::update_golden)
+            {
+                if(verifier.save(AppConfig::golden_path))
+                {
+                    std::cout << "Saved " << verifier.checkedFrames() << " frames to " << AppConfig::golden_path << std::endl;
+                    result = 0;
+                }
+                else std::cerr << "Cannot write golden file " << AppConfig::golden_path << std::endl;
+            }
+            else
             {
-                FPS = (double)fps_count / fps_time * 1000;
-                if(FPS > 60) delay++;
-                else if(delay > 0) delay--;
-                fps_time = 0; fps_count = 0;
+                // a golden frame that is never reached fails as well, otherwise a game that stops drawing would pass
+                unsigned missing = verifier.checkMissing();
+                std::cout << "Checked " << verifier.checkedFrames() << " frames, " << verifier.failedFrames() << " failed";
+                if(missing > 0) std::cout << " (" << missing << " golden frames not drawn)";
+                std::cout << std::endl;
+                result = verifier.failedFrames() == 0 ? 0 : 1;
             }
         }
 
         engine.destroyModules();
     }
 
-    SDL_DestroyWindow(m_window);
-    m_window = nullptr;
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
+    return result;
+}
+
+bool App::nextState()
+{
+    if(m_app_state != nullptr && m_app_state->finished())
+    {
+        AppState* new_state = m_app_state->nextState();
+        delete m_app_state;
+        m_app_state = new_state;
+    }
+    return m_app_state != nullptr;
+}
+
+void App::printPacingStats(const char* name, const PacerStats& stats)
+{
+    std::cout << name << ": " << stats.frames << " frames, frame time " << stats.mean_frame_time << " ms, deviation "
+              << stats.frame_time_deviation << " ms, max lateness " << stats.max_lateness << " ms" << std::endl;
+}
+
+void App::runBenchmark()
+{
+    const int levels_count = Game::lastLevel();
+    double frequency = SDL_GetPerformanceFrequency();
+    Uint64 total_time = 0;
+
+    for(int level = 1; level <= levels_count; level++)
+    {
+        srand(level); // the same enemies in each run
+        std::vector<Player*> players;
+        for(unsigned i = 0; i < 2; i++)
+        {
+            players.push_back(new Player(0, 0, i == 0 ? ST_PLAYER_1 : ST_PLAYER_2));
+            players.back()->player_keys = AppConfig::player_keys.at(i);
+        }
+        Game* game = new Game(players, level - 1);
+
+        // both players follow a fixed script: each holds a random direction for a while, or stops, and fires every few ticks
+        Uint32 script = level;
+        std::vector<Uint8> keys(SDL_NUM_SCANCODES, 0);
+        Uint64 level_time = 0, start;
+        for(unsigned tick = 0; tick < AppConfig::benchmark_level_ticks; tick++)
+        {
+            for(unsigned i = 0; i < players.size(); i++)
+            {
+                const Player::PlayerKeys& k = AppConfig::player_keys.at(i);
+                if((tick + 23 * i) % 48 == 0)
+                {
+                    script = script * 1664525 + 1013904223;
+                    SDL_Scancode moves[5] = {k.up, k.right, k.down, k.left, SDL_SCANCODE_UNKNOWN};
+                    keys[k.up] = keys[k.right] = keys[k.down] = keys[k.left] = 0;
+                    keys[moves[(script >> 16) % 5]] = 1;
+                }
+                keys[k.fire] = (tick + 7 * i) % 16 < 2;
+            }
+            keys[SDL_SCANCODE_UNKNOWN] = 0;
+            Engine::getEngine().getInput()->setKeyboardState(keys.data());
+
+            start = SDL_GetPerformanceCounter();
+            game->update(AppConfig::benchmark_tick_time);
+            level_time += SDL_GetPerformanceCounter() - start;
+        }
+        delete game;
+        total_time += level_time;
+
+        std::cout << "STAGE " << level << ": " << level_time / frequency * 1e6 / AppConfig::benchmark_level_ticks << " us/tick" << std::endl;
+    }
+    std::cout << "TOTAL: " << total_time / frequency * 1e6 / (AppConfig::benchmark_level_ticks * levels_count) << " us/tick" << std::endl;
+}
+
+void App::simulationLoop()
+{
+    InputQueue* input = Engine::getEngine().getInput();
+    std::vector<SDL_Event> events;
+    FramePacer pacer;
+    pacer.setFrameTime(AppConfig::simulation_tick_time);
+
+    while(SDL_AtomicGet(&m_simulation_running))
+    {
+        if(!nextState()) break;
+
+        input->takeEvents(events);
+        if(m_replay.isPlaying())
+        {
+            if(!m_replay.playTick(events)) break; // end of the replay
+            input->setKeyboardState(m_replay.keyboardState());
+        }
+        else m_replay.recordTick(events, input->keyboardState());
+        for(SDL_Event& event : events)
+            m_app_state->eventProcess(&event);
+
+        m_app_state->update(AppConfig::simulation_tick_time);
+        m_app_state->redraw(); // unchanged states publish no frame
+
+        pacer.wait();
+    }
+
+    m_simulation_stats = pacer.stats();
+    SDL_AtomicSet(&m_simulation_running, 0);
+}
+
+int App::simulationThread(void *app)
+{
+    static_cast<App*>(app)->simulationLoop();
+    return 0;
 }
 
 void App::eventProces()
 {
+    Renderer* renderer = Engine::getEngine().getRenderer();
     SDL_Event event;
     while(SDL_PollEvent(&event))
     {
-        if(event.type == SDL_QUIT)
+        if(event.type == renderer->frameEventType())
+        {
+            continue; // only wakes the main thread
+        }
+        else if(event.type == SDL_QUIT)
         {
             is_running = false;
         }
+        else if(event.type == SDL_RENDER_TARGETS_RESET)
+        {
+            renderer->invalidateTerrain();
+            renderer->repaint();
+        }
         else if(event.type == SDL_WINDOWEVENT)
         {
             if(event.window.event == SDL_WINDOWEVENT_RESIZED ||
@@ -112,11 +362,13 @@ void App::eventProces()
 
                 AppConfig::windows_rect.w = event.window.data1;
                 AppConfig::windows_rect.h = event.window.data2;
-                Engine::getEngine().getRenderer()->setScale((float)AppConfig::windows_rect.w / (AppConfig::map_rect.w + AppConfig::status_rect.w),
-                                                            (float)AppConfig::windows_rect.h / AppConfig::map_rect.h);
+                renderer->setScale((float)AppConfig::windows_rect.w / (AppConfig::map_rect.w + AppConfig::status_rect.w),
+                                   (float)AppConfig::windows_rect.h / AppConfig::map_rect.h);
             }
+            renderer->repaint(); // the window content may be lost even if the game does not change
         }
 
-        m_app_state->eventProcess(&event);
+        Engine::getEngine().getInput()->push(event);
     }
+    Engine::getEngine().getInput()->storeKeyboardState();
 }
@@ -2,6 +2,9 @@
 #define APP_H
 
 #include "app_state/appstate.h"
+#include "engine/framepacer.h"
+#include "engine/replay.h"
+#include <SDL2/SDL_atomic.h>
 
 /**
  * @brief
@@ -14,19 +17,60 @@ public:
     ~App();
     /**
      * The function includes the initialization of the SDL2 library, the game engine, and the loading of textures and fonts.
-     * After successful initialization, the program enters the main loop, which sequentially: responds to events,
-     * updates the current state of the application, and draws objects on the screen.
+     * After successful initialization, the simulation thread is started and the program enters the main loop, which sequentially:
+     * passes events to the simulation thread and draws the newest frame published by the simulation, or sleeps if there is nothing new to draw.
+     * @return exit code of the application; nonzero if the initialization failed or a verified frame did not match
      */
-    void run();
+    int run();
     /**
-     * A function that handles events waiting in the queue.
+     * A function that handles events waiting in the queue. Window events are handled immediately, all events and the keyboard state
+     * are passed to the simulation thread.
      */
     void eventProces();
+    /**
+     * The loop of the simulation thread: with a fixed step of @a AppConfig::simulation_tick_time it handles passed events,
+     * updates the current state of the application and records its frame if the state has changed.
+     */
+    void simulationLoop();
+    /**
+     * The function plays all levels one after another for @a AppConfig::benchmark_level_ticks ticks each, without drawing and without waiting,
+     * with two players driven by a fixed script who, like the eagle, never lose the game, and prints the average time of a single @a Game::update call for each level and for the whole run.
+     */
+    void runBenchmark();
+    /**
+     * The function plays the replay @a AppConfig::replay_path without a window and as fast as possible. Every @a AppConfig::verify_frame_step-th
+     * frame is drawn by the software backend and compared with the golden file @a AppConfig::golden_path, or stored in it if @a AppConfig::update_golden is set.
+     * @return 0 if all checked frames matched (or the golden file was written), 1 otherwise
+     */
+    int runHeadless();
 private:
+    /**
+     * Printing statistics of a paced loop (option @a --pacing-stats)
+     * @param name - name of the loop
+     * @param stats - statistics of the loop
+     */
+    static void printPacingStats(const char* name, const PacerStats& stats);
+    /**
+     * Replacing the finished application state with the next one
+     * @return @a false if there is no next state
+     */
+    bool nextState();
+    /**
+     * The function of the simulation thread
+     * @param app - pointer to the application object
+     * @return thread exit code
+     */
+    static int simulationThread(void* app);
+
     /**
      * A variable that keeps the main program loop running.
      */
     bool is_running;
+    /**
+     * A variable that keeps the simulation loop running; cleared by the main thread to stop the simulation
+     * and by the simulation thread when there is no next application state.
+     */
+    SDL_atomic_t m_simulation_running;
     /**
      * The current state of the application.
      */
@@ -35,6 +79,14 @@ private:
      * The application window object.
      */
     SDL_Window* m_window;
+    /**
+     * Input recorded with the option @a --record or played back with the option @a --replay.
+     */
+    Replay m_replay;
+    /**
+     * Pacing statistics of the simulation loop, stored by the simulation thread when it ends.
+     */
+    PacerStats m_simulation_stats;
 };
 
 #endif // APP_H
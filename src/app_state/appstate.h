@@ -7,12 +7,26 @@
 /**
  * @brief
  * The class is an interface from which the classes @a Game, @a Menu, and @a Scores inherit.
+ * A state marks itself as changed with @a invalidate; unchanged states are not drawn again, so no new frame is published and presented.
  */
 class AppState
 {
 public:
+    AppState() : m_dirty(true) {}
     virtual ~AppState() {}
 
+    /**
+     * Drawing the state if it has changed since it was last drawn.
+     * @return @a true if the state was drawn.
+     */
+    bool redraw()
+    {
+        if(!m_dirty) return false;
+        m_dirty = false;
+        draw();
+        return true;
+    }
+
     /**
      * The function checks if the current game state has ended.
      * @return @a true if the current game state has ended, otherwise @a false.
@@ -37,5 +51,17 @@ public:
      * @return Next game state.
      */
     virtual AppState* nextState() = 0;
+
+protected:
+    /**
+     * Marking the state as changed, so that it is drawn in the current tick.
+     */
+    void invalidate() { m_dirty = true; }
+
+private:
+    /**
+     * A variable storing information whether the state has changed since it was last drawn.
+     */
+    bool m_dirty;
 };
 #endif // APPSTATE_H
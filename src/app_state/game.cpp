@@ -7,17 +7,16 @@
 #include <SDL2/SDL.h>
 #include <stdlib.h>
 #include <ctime>
-#include <fstream>
 #include <algorithm>
 #include <iostream>
 #include <cmath>
 
 Game::Game()
 {
-    m_level_columns_count = 0;
-    m_level_rows_count = 0;
+    m_map = nullptr;
     m_current_level = 0;
     m_eagle = nullptr;
+    m_camera = {0, 0};
     m_player_count = 1;
     m_enemy_redy_time = 0;
     m_pause = false;
@@ -25,44 +24,54 @@ Game::Game()
     m_protect_eagle = false;
     m_protect_eagle_time = 0;
     m_enemy_respown_position = 0;
+    configureAI();
     nextLevel();
 }
 
 Game::Game(int players_count)
 {
-    m_level_columns_count = 0;
-    m_level_rows_count = 0;
+    m_map = nullptr;
     m_current_level = 0;
     m_eagle = nullptr;
+    m_camera = {0, 0};
     m_player_count = players_count;
+    m_enemy_redy_time = 0;
     m_pause = false;
     m_level_end_time = 0;
     m_protect_eagle = false;
     m_protect_eagle_time = 0;
     m_enemy_respown_position = 0;
+    configureAI();
     nextLevel();
 }
 
 Game::Game(std::vector<Player *> players, int previous_level)
 {
-    m_level_columns_count = 0;
-    m_level_rows_count = 0;
+    m_map = nullptr;
     m_current_level = previous_level;
     m_eagle = nullptr;
+    m_camera = {0, 0};
     m_players = players;
     m_player_count = m_players.size();
-    for(auto player : m_players)
-    {
-        player->clearFlag(TSF_MENU);
-        player->lives_count++;
-        player->respawn();
-    }
+    m_enemy_redy_time = 0;
     m_pause = false;
     m_level_end_time = 0;
     m_protect_eagle = false;
     m_protect_eagle_time = 0;
     m_enemy_respown_position = 0;
+    configureAI();
     nextLevel();
+
+    // players coming from the previous level start at the spawn points of the new map
+    const std::vector<SDL_Point>& spawns = m_map->data().playerSpawns().empty() ? AppConfig::player_starting_point : m_map->data().playerSpawns();
+    for(auto player : m_players)
+    {
+        player->clearFlag(TSF_MENU);
+        player->lives_count++;
+        player->starting_point = spawns.at(player->type == ST_PLAYER_1 ? 0 : 1);
+        player->respawn();
+    }
+    updateCamera();
 }
 
 Game::~Game()
@@ -84,16 +93,42 @@ void Game::draw()
     else
     {
         renderer->drawRect(&AppConfig::map_rect, {0, 0, 0, 0}, true);
-        for(auto row : m_level)
-            for(auto item : row)
-                if(item != nullptr) item->draw();
+        renderer->setCamera(m_camera.x, m_camera.y);
+
+        // Only chunks of the map around the visible area are visited, so drawing does not depend on the size of the map.
+        // The area is one tile larger on each side, because sprites may still be moving into view.
+        SDL_Rect view = {m_camera.x - AppConfig::tile_rect.w, m_camera.y - AppConfig::tile_rect.h,
+                         AppConfig::map_rect.w + 2 * AppConfig::tile_rect.w, AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h};
+        SDL_Rect chunks = m_map->chunksIn(view);
+
+        // Static map cells are drawn from the terrain cache, water is drawn on top of it.
+        // Map tiles and bushes never override Object::draw, so they are drawn without virtual calls.
+        // All water tiles show the same frame of the shared clock, so only visible ones are switched to it.
+        renderer->setLayer(RL_TERRAIN);
+        renderer->drawTerrain();
+        renderer->setLayer(RL_WATER);
+        for(int y = chunks.y; y < chunks.y + chunks.h; y++)
+            for(int x = chunks.x; x < chunks.x + chunks.w; x++)
+                for(auto cell : m_map->chunk(y, x).water)
+                {
+                    Object* item = m_map->tile(cell.y, cell.x);
+                    if(item == nullptr || item->type != ST_WATER) continue;
+                    item->setFrame(m_water_frame);
+                    item->drawSprite();
+                }
 
+        renderer->setLayer(RL_TANKS);
         for(auto player : m_players) player->draw();
         for(auto enemy : m_enemies) enemy->draw();
-        for(auto bush : m_bushes) bush->draw();
+        renderer->setLayer(RL_BUSHES);
+        for(int y = chunks.y; y < chunks.y + chunks.h; y++)
+            for(int x = chunks.x; x < chunks.x + chunks.w; x++)
+                for(auto bush : m_map->chunk(y, x).bushes) bush->drawSprite();
+        renderer->setLayer(RL_ITEMS);
         for(auto bonus : m_bonuses) bonus->draw();
         m_eagle->draw();
 
+        renderer->setLayer(RL_TEXT);
         if(m_game_over)
         {
             SDL_Point pos;
@@ -103,6 +138,7 @@ void Game::draw()
         }
 
         //=========== Game status ===========
+        renderer->setLayer(RL_STATUS);
         SDL_Rect src = engine.getSpriteConfig()->getSpriteData(ST_LEFT_ENEMY)->rect;
         SDL_Rect dst;
         SDL_Point p_dst;
@@ -129,8 +165,18 @@ void Game::draw()
         renderer->drawObject(&src, &dst);
         renderer->drawText(&p_dst, Engine::intToString(m_current_level), {0, 0, 0, 255}, 2);
 
+        renderer->setLayer(RL_TEXT);
         if(m_pause)
             renderer->drawText(nullptr, std::string("PAUSE"), {200, 0, 0, 255}, 1);
+
+        if(AppConfig::show_render_stats)
+        {
+            RenderStats stats = renderer->frameStats();
+            p_dst = {4, 4};
+            renderer->drawText(&p_dst, "DRAW CALLS " + Engine::intToString(stats.draw_calls) + "  QUADS " + Engine::intToString(stats.quads), {255, 255, 0, 255}, 3);
+            p_dst = {4, 14};
+            renderer->drawText(&p_dst, "AI " + Engine::intToString(m_ai_scheduler.lastDecisions()) + "/" + Engine::intToString(m_enemies.size()), {255, 255, 0, 255}, 3);
+        }
     }
 
     renderer->flush();
@@ -142,14 +188,26 @@ void Game::update(Uint32 dt)
 
     if(m_level_start_screen)
     {
+        // the stage number screen does not change until it ends
         if(m_level_start_time > AppConfig::level_start_time)
+        {
             m_level_start_screen = false;
+            invalidate();
+        }
 
         m_level_start_time += dt;
     }
     else
     {
         if(m_pause) return;
+        invalidate();
+
+        // The benchmark plays every stage for its whole length: players keep their last life and enemies keep coming
+        if(AppConfig::benchmark)
+        {
+            for(auto player : m_players) player->lives_count = std::max(player->lives_count, 2);
+            if(m_enemy_to_kill <= 0) m_enemy_to_kill = AppConfig::enemy_start_count;
+        }
 
         std::vector<Player*>::iterator pl1, pl2;
         std::vector<Enemy*>::iterator en1, en2;
@@ -205,51 +263,24 @@ void Game::update(Uint32 dt)
         for(auto enemy : m_enemies) checkCollisionTankWithLevel(enemy, dt);
         for(auto player : m_players) checkCollisionTankWithLevel(player, dt);
 
-        // Assigning targets to enemies
-        int min_metric; // 2 * 26 * 16
-        int metric;
-        SDL_Point target;
-        for(auto enemy : m_enemies)
-        {
-            min_metric = 832;
-            if(enemy->type == ST_TANK_A || enemy->type == ST_TANK_D)
-                for(auto player : m_players)
-                {
-                    metric = fabs(player->dest_rect.x - enemy->dest_rect.x) + fabs(player->dest_rect.y - enemy->dest_rect.y);
-                    if(metric < min_metric)
-                    {
-                        min_metric = metric;
-                        target = {player->dest_rect.x + player->dest_rect.w / 2, player->dest_rect.y + player->dest_rect.h / 2};
-                    }
-                }
-            metric = fabs(m_eagle->dest_rect.x - enemy->dest_rect.x) + fabs(m_eagle->dest_rect.y - enemy->dest_rect.y);
-            if(metric < min_metric)
-            {
-                min_metric = metric;
-                target = {m_eagle->dest_rect.x + m_eagle->dest_rect.w / 2, m_eagle->dest_rect.y + m_eagle->dest_rect.h / 2};
-            }
-
-            enemy->target_position = target;
-        }
-
-        // Update all objects
+        // Update all objects; the containers hold final classes, so the calls are resolved statically
         for(auto enemy : m_enemies) enemy->update(dt);
+        // Enemy decisions (target, route, direction, shots) follow their movement, as the decisions made at the end of Enemy::update did,
+        // and are spread over ticks by the scheduler, while the movement is updated every tick
+        thinkEnemies();
         for(auto player : m_players) player->update(dt);
         for(auto bonus : m_bonuses) bonus->update(dt);
         m_eagle->update(dt);
 
-        for(auto row : m_level)
-            for(auto item : row)
-                if(item != nullptr) item->update(dt);
-
-
-        for(auto bush : m_bushes) bush->update(dt);
+        // Map tiles are dispatched by their type: bricks, stones and ice are static, only water is animated.
+        // Water tiles take the frame of the shared clock when they are drawn. Bushes are static as well and are not updated at all.
+        m_animation_clock.update(dt);
+        m_water_frame = m_animation_clock.frame(Engine::getEngine().getSpriteConfig()->getSpriteData(ST_WATER));
 
         // Removal of unnecessary elements
         m_enemies.erase(std::remove_if(m_enemies.begin(), m_enemies.end(), [](Enemy*e){if(e->to_erase) {delete e; return true;} return false;}), m_enemies.end());
         m_players.erase(std::remove_if(m_players.begin(), m_players.end(), [this](Player*p){if(p->to_erase) {m_killed_players.push_back(p); return true;} return false;}), m_players.end());
         m_bonuses.erase(std::remove_if(m_bonuses.begin(), m_bonuses.end(), [](Bonus*b){if(b->to_erase) {delete b; return true;} return false;}), m_bonuses.end());
-        m_bushes.erase(std::remove_if(m_bushes.begin(), m_bushes.end(), [](Object*b){if(b->to_erase) {delete b; return true;} return false;}), m_bushes.end());
 
         // Adding a new enemy
         m_enemy_redy_time += dt;
@@ -286,63 +317,55 @@ void Game::update(Uint32 dt)
             {
                 m_protect_eagle = false;
                 m_protect_eagle_time = 0;
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Brick(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h);
-
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Brick(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Brick(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h);
-                }
+                setEagleWall(ST_BRICK_WALL);
             }
 
             if(m_protect_eagle && m_protect_eagle_time > AppConfig::protect_eagle_time / 4 * 3 && m_protect_eagle_time / AppConfig::bonus_blink_time % 2)
-            {
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Brick(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h);
-
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Brick(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Brick(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h);
-                }
-            }
+                setEagleWall(ST_BRICK_WALL);
             else if(m_protect_eagle)
-            {
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Object(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h, ST_STONE_WALL);
-
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Object(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h, ST_STONE_WALL);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Object(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h, ST_STONE_WALL);
-                }
-            }
+                setEagleWall(ST_STONE_WALL);
         }
+
+        updateCamera();
+    }
+}
+
+FlowField& Game::playerFlow(const Player* player)
+{
+    return m_player_flows[player->type == ST_PLAYER_1 ? 0 : 1];
+}
+
+void Game::thinkEnemies()
+{
+    // Each player has its own field whatever happens to the other one, so an enemy keeps a valid pointer to the field of its player between decisions
+    m_world.map = m_map;
+    m_world.eagle = m_eagle->dest_rect;
+    m_world.eagle_flow = &m_map->eagleFlow();
+    m_world.players.clear();
+    m_world.player_flows.clear();
+    for(unsigned i = 0; i < m_players.size(); i++)
+    {
+        m_world.players.push_back(m_players[i]->dest_rect);
+        m_world.player_flows.push_back(&playerFlow(m_players[i]));
+    }
+
+    m_ai_scheduler.select(m_enemies.size(), m_thinking_enemies);
+    Uint64 start = SDL_GetPerformanceCounter();
+    auto think = [this](unsigned k){ m_enemies[m_thinking_enemies[k]]->think(m_world); };
+    Engine::getEngine().getJobSystem()->run(m_thinking_enemies.size(), think);
+    m_ai_scheduler.reportTime(SDL_GetPerformanceCounter() - start);
+
+    for(unsigned i : m_thinking_enemies)
+    {
+        Enemy* enemy = m_enemies[i];
+        enemy->apply();
+
+        // the field toward a chased player follows it to its current cell and leads the enemies chasing it from their next decisions
+        int chased = enemy->chasedPlayer();
+        if(chased < 0) continue;
+        SDL_Point position = FlowField::positionOf(m_players[chased]->dest_rect);
+        FlowField& flow = playerFlow(m_players[chased]);
+        if(flow.target().x != position.x || flow.target().y != position.y) flow.build(*m_map, position, player_flow_radius);
     }
 }
 
@@ -350,6 +373,7 @@ void Game::eventProcess(SDL_Event *ev)
 {
     if(ev->type == SDL_KEYDOWN)
     {
+        invalidate();
         switch(ev->key.keysym.sym)
         {
         case SDLK_n:
@@ -364,6 +388,9 @@ void Game::eventProcess(SDL_Event *ev)
         case SDLK_t:
             AppConfig::show_enemy_target = !AppConfig::show_enemy_target;
             break;
+        case SDLK_f:
+            AppConfig::show_render_stats = !AppConfig::show_render_stats;
+            break;
         case SDLK_RETURN:
             m_pause = !m_pause;
             break;
@@ -374,68 +401,54 @@ void Game::eventProcess(SDL_Event *ev)
     }
 }
 
-/*
-. = empty field
-# = brick wall
-@ = stone
-% = bushes
-~ = water
-- = ice
- */
-
-void Game::loadLevel(std::string path)
+void Game::loadLevel(int number)
 {
-    std::fstream level(path, std::ios::in);
-    std::string line;
-    int j = -1;
-
-    if(level.is_open())
+    LevelMap* map = Engine::getEngine().getLevelPrefetcher()->take(number);
+    if(map == nullptr)
     {
-        while(!level.eof())
-        {
-            std::getline(level, line);
-            std::vector<Object*> row;
-            j++;
-            for(unsigned i = 0; i < line.size(); i++)
-            {
-                Object* obj;
-                switch(line.at(i))
-                {
-                case '#' : obj = new Brick(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h); break;
-                case '@' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_STONE_WALL); break;
-                case '%' : m_bushes.push_back(new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_BUSH)); obj =  nullptr; break;
-                case '~' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_WATER); break;
-                case '-' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_ICE); break;
-                default: obj = nullptr;
-                }
-                row.push_back(obj);
-            }
-            m_level.push_back(row);
-        }
+        map = new LevelMap;
+        if(!map->load(number))
+            std::cerr << "Cannot load level " << AppConfig::levels_path << number << std::endl;
     }
+    delete m_map;
+    m_map = map;
+
+    // We create the eagle; its spot is cleared by the level compiler
+    SDL_Point eagle = m_map->data().eagle();
+    m_eagle = new Eagle(eagle.x * AppConfig::tile_rect.w, eagle.y * AppConfig::tile_rect.h);
 
-    m_level_rows_count = m_level.size();
-    if(m_level_rows_count)
-        m_level_columns_count = m_level.at(0).size();
-    else m_level_columns_count = 0;
+    // The terrain cache is baked together with the map, so the renderer only takes its chunks over
+    Engine::getEngine().getRenderer()->setTerrain(m_map->columns(), m_map->rows(), m_map->terrainChunks());
+
+    // The map comes with the routes toward the eagle over the whole level; the fields toward players are built when enemies chase them
+    for(auto& flow : m_player_flows) flow = FlowField();
+    m_ai_scheduler.reset();
+}
 
-    // We create the eagle
-    m_eagle = new Eagle(12 * AppConfig::tile_rect.w, (m_level_rows_count - 2) * AppConfig::tile_rect.h);
+int Game::lastLevel()
+{
+    int count = Engine::getEngine().getLevelPack()->count();
+    if(count > 0) return count;
 
-    // Clearing the eagle's spot
-    for(int i = 12; i < 14 && i < m_level_columns_count; i++)
+    // Without a pack the stages are the level files, numbered from 1 without a gap
+    for(;; count++)
     {
-        for(int j = m_level_rows_count - 2; j < m_level_rows_count; j++)
-        {
-            if(m_level.at(j).at(i) != nullptr)
-            {
-                delete m_level.at(j).at(i);
-                m_level.at(j).at(i) = nullptr;
-            }
-        }
+        std::string path = AppConfig::levels_path + Engine::intToString(count + 1);
+        SDL_RWops* file = SDL_RWFromFile((path + ".lvl").c_str(), "rb");
+        if(file == nullptr) file = SDL_RWFromFile(path.c_str(), "rb");
+        if(file == nullptr) return count;
+        SDL_RWclose(file);
     }
 }
 
+int Game::followingLevel(int level)
+{
+    level++;
+    if(level > lastLevel() && !AppConfig::endless_levels) level = 1;
+    if(level < 0) level = lastLevel();
+    return level;
+}
+
 bool Game::finished() const
 {
     return m_finished;
@@ -453,6 +466,13 @@ AppState* Game::nextState()
     return m;
 }
 
+void Game::configureAI()
+{
+    // a time budget makes decisions depend on the speed of the machine, so recorded games are played without it
+    bool deterministic = !AppConfig::record_path.empty() || !AppConfig::replay_path.empty();
+    m_ai_scheduler.configure(AppConfig::ai_think_interval, deterministic ? 0 : AppConfig::ai_budget);
+}
+
 void Game::clearLevel()
 {
     for(auto enemy : m_enemies) delete enemy;
@@ -464,18 +484,55 @@ void Game::clearLevel()
     for(auto bonus : m_bonuses) delete bonus;
     m_bonuses.clear();
 
-    for(auto row : m_level)
+    delete m_map;
+    m_map = nullptr;
+
+    if(m_eagle != nullptr) delete m_eagle;
+    m_eagle = nullptr;
+}
+
+void Game::setLevelTile(int row, int column, SpriteType type)
+{
+    Object* tile = m_map->setTile(row, column, type);
+    if(tile != nullptr && type == ST_WATER) tile->setFrame(m_water_frame);
+    updateTerrainTile(row, column);
+
+    m_map->eagleFlow().update(*m_map, row, column);
+    for(auto& flow : m_player_flows) flow.update(*m_map, row, column);
+}
+
+void Game::updateTerrainTile(int row, int column)
+{
+    Object* tile = m_map->tile(row, column);
+    Renderer* renderer = Engine::getEngine().getRenderer();
+    if(tile == nullptr || tile->to_erase || tile->type == ST_WATER)
+        renderer->setTerrainTile(column, row, nullptr);
+    else
+        renderer->setTerrainTile(column, row, &tile->src_rect);
+}
+
+void Game::setEagleWall(SpriteType type)
+{
+    // the wall surrounds the 2x2 cells of the eagle from the left, the top and the right
+    SDL_Point eagle = m_map->data().eagle();
+    std::vector<SDL_Point> cells; // x - column, y - row
+    for(int i = -1; i < 2; i++)
     {
-        for(auto item : row) if(item != nullptr) delete item;
-        row.clear();
+        cells.push_back({eagle.x - 1, eagle.y + i});
+        cells.push_back({eagle.x + 2, eagle.y + i});
     }
-    m_level.clear();
+    for(int i = 0; i < 2; i++)
+        cells.push_back({eagle.x + i, eagle.y - 1});
 
-    for(auto bush : m_bushes)  delete bush;
-    m_bushes.clear();
+    for(auto cell : cells)
+    {
+        if(cell.x < 0 || cell.y < 0 || cell.x >= m_map->columns() || cell.y >= m_map->rows()) continue;
+        Object* current = m_map->tile(cell.y, cell.x);
+        if(current != nullptr && current->type == type && (type != ST_BRICK_WALL || static_cast<Brick*>(current)->isIntact()))
+            continue;
 
-    if(m_eagle != nullptr) delete m_eagle;
-    m_eagle = nullptr;
+        setLevelTile(cell.y, cell.x, type);
+    }
 }
 
 void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
@@ -518,8 +575,8 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     }
     if(column_start < 0) column_start = 0;
     if(row_start < 0) row_start = 0;
-    if(column_end >= m_level_columns_count) column_end = m_level_columns_count - 1;
-    if(row_end >= m_level_rows_count) row_end = m_level_rows_count - 1;
+    if(column_end >= m_map->columns()) column_end = m_map->columns() - 1;
+    if(row_end >= m_map->rows()) row_end = m_map->rows() - 1;
 
     pr = tank->nextCollisionRect(dt);
     SDL_Rect intersect_rect;
@@ -529,7 +586,7 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
         for(int j = column_start; j <= column_end ;j++)
         {
             if(tank->stop) break;
-            o = m_level.at(i).at(j);
+            o = m_map->tile(i, j);
             if(o == nullptr) continue;
             if(tank->testFlag(TSF_BOAT) && o->type == ST_WATER) continue;
 
@@ -556,16 +613,16 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     outside_map_rect.x = -AppConfig::tile_rect.w;
     outside_map_rect.y = -AppConfig::tile_rect.h;
     outside_map_rect.w = AppConfig::tile_rect.w;
-    outside_map_rect.h = AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h;
+    outside_map_rect.h = m_map->height() + 2 * AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
         tank->collide(intersect_rect);
 
     // Rectangle on the right side of the map
-    outside_map_rect.x = AppConfig::map_rect.w;
+    outside_map_rect.x = m_map->width();
     outside_map_rect.y = -AppConfig::tile_rect.h;
     outside_map_rect.w = AppConfig::tile_rect.w;
-    outside_map_rect.h = AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h;
+    outside_map_rect.h = m_map->height() + 2 * AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
         tank->collide(intersect_rect);
@@ -573,7 +630,7 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     // Rectangle on the top side of the map
     outside_map_rect.x = 0;
     outside_map_rect.y = -AppConfig::tile_rect.h;
-    outside_map_rect.w = AppConfig::map_rect.w;
+    outside_map_rect.w = m_map->width();
     outside_map_rect.h = AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
@@ -581,8 +638,8 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
 
     // Rectangle on the bottom side of the map
     outside_map_rect.x = 0;
-    outside_map_rect.y = AppConfig::map_rect.h;
-    outside_map_rect.w = AppConfig::map_rect.w;
+    outside_map_rect.y = m_map->height();
+    outside_map_rect.w = m_map->width();
     outside_map_rect.h = AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
@@ -646,15 +703,15 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
     }
     if(column_start < 0) column_start = 0;
     if(row_start < 0) row_start = 0;
-    if(column_end >= m_level_columns_count) column_end = m_level_columns_count - 1;
-    if(row_end >= m_level_rows_count) row_end = m_level_rows_count - 1;
+    if(column_end >= m_map->columns()) column_end = m_map->columns() - 1;
+    if(row_end >= m_map->rows()) row_end = m_map->rows() - 1;
 
     br = &bullet->collision_rect;
 
     for(int i = row_start; i <= row_end; i++)
         for(int j = column_start; j <= column_end; j++)
         {
-            o = m_level.at(i).at(j);
+            o = m_map->tile(i, j);
             if(o == nullptr) continue;
             if(o->type == ST_ICE || o->type == ST_WATER) continue;
 
@@ -665,25 +722,23 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
             {
                 if(bullet->increased_damage)
                 {
-                    delete o;
-                    m_level.at(i).at(j) = nullptr;
+                    setLevelTile(i, j, ST_NONE);
                 }
                 else if(o->type == ST_BRICK_WALL)
                 {
-                    Brick* brick = dynamic_cast<Brick*>(o);
+                    Brick* brick = static_cast<Brick*>(o); // only Brick objects have the ST_BRICK_WALL type
                     brick->bulletHit(bullet->direction);
                     if(brick->to_erase)
-                    {
-                        delete brick;
-                        m_level.at(i).at(j) = nullptr;
-                    }
+                        setLevelTile(i, j, ST_NONE);
+                    else
+                        updateTerrainTile(i, j);
                 }
                 bullet->destroy();
             }
         }
 
     //======================== Collision with map boundaries ========================
-    if(br->x < 0 || br->y < 0 || br->x + br->w > AppConfig::map_rect.w || br->y + br->h > AppConfig::map_rect.h)
+    if(br->x < 0 || br->y < 0 || br->x + br->w > m_map->width() || br->y + br->h > m_map->height())
     {
         bullet->destroy();
     }
@@ -694,6 +749,7 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
         if(intersect_rect.w > 0 && intersect_rect.h > 0)
         {
             bullet->destroy();
+            if(AppConfig::benchmark) return; // the eagle survives, see Game::update
             m_eagle->destroy();
             m_game_over_position = AppConfig::map_rect.h;
             m_game_over = true;
@@ -711,18 +767,25 @@ void Game::checkCollisionBulletWithBush(Bullet *bullet)
     SDL_Rect intersect_rect;
     br = &bullet->collision_rect;
 
-    for(auto bush : m_bushes)
-    {
-        if(bush->to_erase) continue;
-        lr = &bush->collision_rect;
-        intersect_rect = intersectRect(lr, br);
-
-        if(intersect_rect.w > 0 && intersect_rect.h > 0)
+    // only bushes of the chunks under the bullet are checked; hit bushes are removed from their chunk at once
+    SDL_Rect chunks = m_map->chunksIn(*br);
+    for(int y = chunks.y; y < chunks.y + chunks.h; y++)
+        for(int x = chunks.x; x < chunks.x + chunks.w; x++)
         {
-            bullet->destroy();
-            bush->to_erase = true;
+            std::vector<Object*>& bushes = m_map->chunk(y, x).bushes;
+            for(auto bush : bushes)
+            {
+                lr = &bush->collision_rect;
+                intersect_rect = intersectRect(lr, br);
+
+                if(intersect_rect.w > 0 && intersect_rect.h > 0)
+                {
+                    bullet->destroy();
+                    bush->to_erase = true;
+                }
+            }
+            bushes.erase(std::remove_if(bushes.begin(), bushes.end(), [](Object*b){return b->to_erase;}), bushes.end());
         }
-    }
 }
 
 void Game::checkCollisionPlayerBulletsWithEnemy(Player *player, Enemy *enemy)
@@ -816,22 +879,7 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
         {
             m_protect_eagle = true;
             m_protect_eagle_time = 0;
-            for(int i = 0; i < 3; i++)
-            {
-                if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                    delete m_level.at(m_level_rows_count - i - 1).at(11);
-                m_level.at(m_level_rows_count - i - 1).at(11) = new Object(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h, ST_STONE_WALL);
-
-                if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                    delete m_level.at(m_level_rows_count - i - 1).at(14);
-                m_level.at(m_level_rows_count - i - 1).at(14) = new Object(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h, ST_STONE_WALL);
-            }
-            for(int i = 12; i < 14; i++)
-            {
-                if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                    delete m_level.at(m_level_rows_count - 3).at(i);
-                m_level.at(m_level_rows_count - 3).at(i) = new Object(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h, ST_STONE_WALL);
-            }
+            setEagleWall(ST_STONE_WALL);
         }
         else if(bonus->type == ST_BONUS_TANK)
         {
@@ -855,9 +903,7 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
 
 void Game::nextLevel()
 {
-    m_current_level++;
-    if(m_current_level > 35) m_current_level = 1;
-    if(m_current_level < 0) m_current_level = 35;
+    m_current_level = followingLevel(m_current_level);
 
     m_level_start_screen = true;
     m_level_start_time = 0;
@@ -865,15 +911,17 @@ void Game::nextLevel()
     m_finished = false;
     m_enemy_to_kill = AppConfig::enemy_start_count;
 
-    std::string level_path = AppConfig::levels_path + Engine::intToString(m_current_level);
-    loadLevel(level_path);
+    m_animation_clock.reset();
+    m_water_frame = 0;
+    loadLevel(m_current_level);
 
     if(m_players.empty())
     {
+        const std::vector<SDL_Point>& spawns = m_map->data().playerSpawns().empty() ? AppConfig::player_starting_point : m_map->data().playerSpawns();
         if(m_player_count == 2)
         {
-            Player* p1 = new Player(AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1);
-            Player* p2 = new Player(AppConfig::player_starting_point.at(1).x, AppConfig::player_starting_point.at(1).y, ST_PLAYER_2);
+            Player* p1 = new Player(spawns.at(0).x, spawns.at(0).y, ST_PLAYER_1);
+            Player* p2 = new Player(spawns.at(1).x, spawns.at(1).y, ST_PLAYER_2);
             p1->player_keys = AppConfig::player_keys.at(0);
             p2->player_keys = AppConfig::player_keys.at(1);
             m_players.push_back(p1);
@@ -882,20 +930,43 @@ void Game::nextLevel()
         }
         else
         {
-            Player* p1 = new Player(AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1);
+            Player* p1 = new Player(spawns.at(0).x, spawns.at(0).y, ST_PLAYER_1);
             p1->player_keys = AppConfig::player_keys.at(0);
             m_players.push_back(p1);
         }
     }
+    updateCamera();
+}
+
+void Game::updateCamera()
+{
+    SDL_Point center = {m_eagle->dest_rect.x + m_eagle->dest_rect.w / 2, m_eagle->dest_rect.y + m_eagle->dest_rect.h / 2};
+    if(!m_players.empty())
+    {
+        center = {0, 0};
+        for(auto player : m_players)
+        {
+            center.x += player->dest_rect.x + player->dest_rect.w / 2;
+            center.y += player->dest_rect.y + player->dest_rect.h / 2;
+        }
+        center.x /= static_cast<int>(m_players.size());
+        center.y /= static_cast<int>(m_players.size());
+    }
+
+    int max_x = m_map->width() - AppConfig::map_rect.w;
+    int max_y = m_map->height() - AppConfig::map_rect.h;
+    m_camera.x = max_x > 0 ? std::max(0, std::min(center.x - AppConfig::map_rect.w / 2, max_x)) : max_x / 2;
+    m_camera.y = max_y > 0 ? std::max(0, std::min(center.y - AppConfig::map_rect.h / 2, max_y)) : max_y / 2;
 }
 
 void Game::generateEnemy()
 {
     float p = static_cast<float>(rand()) / RAND_MAX;
     SpriteType type = static_cast<SpriteType>(p < (0.00735 * m_current_level + 0.09265) ? ST_TANK_D : rand() % (ST_TANK_C - ST_TANK_A + 1) + ST_TANK_A);
-    Enemy* e = new Enemy(AppConfig::enemy_starting_point.at(m_enemy_respown_position).x, AppConfig::enemy_starting_point.at(m_enemy_respown_position).y, type);
+    const std::vector<SDL_Point>& spawns = m_map->data().enemySpawns().empty() ? AppConfig::enemy_starting_point : m_map->data().enemySpawns();
+    if(m_enemy_respown_position >= static_cast<int>(spawns.size())) m_enemy_respown_position = 0;
+    Enemy* e = new Enemy(spawns.at(m_enemy_respown_position).x, spawns.at(m_enemy_respown_position).y, type);
     m_enemy_respown_position++;
-    if(m_enemy_respown_position >= AppConfig::enemy_starting_point.size()) m_enemy_respown_position = 0;
 
     double a, b, c;
     if(m_current_level <= 17)
@@ -926,11 +997,16 @@ void Game::generateEnemy()
 void Game::generateBonus()
 {
     Bonus* b = new Bonus(0, 0, static_cast<SpriteType>(rand() % (ST_BONUS_BOAT - ST_BONUS_GRENADE + 1) + ST_BONUS_GRENADE));
+    // the bonus appears in the visible part of the map
+    SDL_Rect view = {m_camera.x, m_camera.y, AppConfig::map_rect.w, AppConfig::map_rect.h};
+    SDL_Rect map = {0, 0, m_map->width(), m_map->height()};
+    SDL_Rect area = intersectRect(&view, &map);
+    if(area.w <= AppConfig::tile_rect.w || area.h <= AppConfig::tile_rect.h) area = map;
     SDL_Rect intersect_rect;
     do
     {
-        b->pos_x = rand() % (AppConfig::map_rect.x + AppConfig::map_rect.w - 1 *  AppConfig::tile_rect.w);
-        b->pos_y = rand() % (AppConfig::map_rect.y + AppConfig::map_rect.h - 1 * AppConfig::tile_rect.h);
+        b->pos_x = intToFixed(area.x + rand() % (area.w - 1 * AppConfig::tile_rect.w));
+        b->pos_y = intToFixed(area.y + rand() % (area.h - 1 * AppConfig::tile_rect.h));
         b->update(0);
         intersect_rect = intersectRect(&b->collision_rect, &m_eagle->collision_rect);
     }while(intersect_rect.w > 0 && intersect_rect.h > 0);
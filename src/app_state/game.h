@@ -8,6 +8,10 @@
 #include "../objects/brick.h"
 #include "../objects/eagle.h"
 #include "../objects/bonus.h"
+#include "../engine/animationclock.h"
+#include "../engine/aischeduler.h"
+#include "../level/levelmap.h"
+#include "../level/flowfield.h"
 #include <vector>
 #include <string>
 
@@ -68,20 +72,74 @@ public:
      * @return Pointer to an object of class @a Scores if the player has completed the round or lost. If the player pressed Esc, the function returns a pointer to the @a Menu object.
      */
     AppState* nextState();
+    /**
+     * @return number of the last level: the number of stages of the level pack, or without a pack the number of level files numbered from 1
+     */
+    static int lastLevel();
+    /**
+     * @param level - number of the current level
+     * @return number of the level played after the given one; the first level follows the last one unless @a AppConfig::endless_levels is set
+     */
+    static int followingLevel(int level);
 
 private:
     /**
-     * Loading the level map from a file
-     * @param path - Path to the map file
+     * Largest distance in cells of the positions covered by a field toward a player; the classic 26x26 maps are covered whole
      */
-    void loadLevel(std::string path);
+    static const int player_flow_radius = 32;
+
+    /**
+     * Loading the level map. A map prefetched during the score screen is taken over; otherwise the map is loaded now.
+     * @param number - Number of the level
+     * @see LevelMap::load
+     */
+    void loadLevel(int number);
     /**
      * Removing remaining enemies, players, map objects, and bonuses
      */
     void clearLevel();
+    /**
+     * Replacing the object in the selected map cell. The change is reported to the terrain cache and the flow fields of enemies are repaired around the cell.
+     * @param row - row of the cell
+     * @param column - column of the cell
+     * @param type - type of the new object; @a ST_NONE empties the cell
+     */
+    void setLevelTile(int row, int column, SpriteType type);
+    /**
+     * Decisions of the enemies chosen by the AI scheduler: the enemies think in parallel on the job system against @a m_world,
+     * then their decisions are carried out one by one in the order of the scheduler, so the game is the same on any number of threads
+     */
+    void thinkEnemies();
+    /**
+     * @param player - player chased by enemies
+     * @return field of routes toward the player, chosen by the type of the player
+     */
+    FlowField& playerFlow(const Player* player);
+    /**
+     * Setting the limits of the AI scheduler from @a AppConfig::ai_think_interval and @a AppConfig::ai_budget; recorded and replayed games run without the time budget
+     */
+    void configureAI();
+    /**
+     * Reporting the current appearance of the selected map cell to the terrain cache of the renderer.
+     * Water is reported as an empty cell because it is animated and drawn separately.
+     * @param row - row of the cell
+     * @param column - column of the cell
+     */
+    void updateTerrainTile(int row, int column);
+    /**
+     * Setting the wall around the eagle. Cells that already contain an intact wall of the given type are left untouched,
+     * so the terrain cache is redrawn only when the wall really changes.
+     * @param type - type of the wall: @a ST_BRICK_WALL or @a ST_STONE_WALL
+     */
+    void setEagleWall(SpriteType type);
+    /**
+     * Moving the camera to the middle between the players, or to the eagle if no player is left. The camera stays inside the map;
+     * a map smaller than the map area is centered in it.
+     */
+    void updateCamera();
     /**
      * Loading a new level and creating new players if they do not already exist.
-     * @see Game::loadLevel(std::string path)
+     * @see Game::loadLevel(int number)
      */
     void nextLevel();
     /**
@@ -92,7 +150,7 @@ private:
      */
     void generateEnemy();
     /**
-     * The function generates a random bonus on the map and places it in a position that does not collide with the eagle.
+     * The function generates a random bonus in the visible part of the map and places it in a position that does not collide with the eagle.
      */
     void generateBonus();
 
@@ -157,21 +215,39 @@ private:
     void checkCollisionPlayerWithBonus(Player* player, Bonus* bonus);
 
     /**
-     * Number of columns in the map grid
+     * Map of the current level: obstacles, bushes and water
+     */
+    LevelMap* m_map;
+    /**
+     * Clock of looped map animations
+     */
+    AnimationClock m_animation_clock;
+    /**
+     * Frame of water shown by all water tiles
+     */
+    int m_water_frame;
+    /**
+     * Position of the visible part of the map in pixels
+     */
+    SDL_Point m_camera;
+    /**
+     * Routes of enemies toward the players, the first one toward @a ST_PLAYER_1 and the second one toward @a ST_PLAYER_2; a field is rebuilt only when an enemy chases
+     * its player and the player has moved to another cell. It covers only the positions within @a player_flow_radius of the player, so a rebuild costs the same on any size
+     * of the map; farther enemies head toward the player directly.
      */
-    int m_level_columns_count;
+    FlowField m_player_flows[2];
     /**
-     * Number of rows in the map grid
+     * Scheduler spreading enemy decisions over ticks
      */
-    int m_level_rows_count;
+    AIScheduler m_ai_scheduler;
     /**
-     * Obstacles on the map
+     * Indices of the enemies thinking in the current tick
      */
-    std::vector< std::vector <Object*> > m_level;
+    std::vector<unsigned> m_thinking_enemies;
     /**
-     * Bushes on the map
+     * World seen by the enemies thinking in the current tick
      */
-    std::vector<Object*> m_bushes;
+    WorldSnapshot m_world;
 
     /**
      * Set of enemies
@@ -15,8 +15,8 @@ Menu::Menu()
     m_menu_index = 0;
     m_tank_pointer = new Player(0, 0 , ST_PLAYER_1);
     m_tank_pointer->direction = D_RIGHT;
-    m_tank_pointer->pos_x = 144;
-    m_tank_pointer->pos_y = (m_menu_index + 1) * 32 + 112;
+    m_tank_pointer->pos_x = intToFixed(144);
+    m_tank_pointer->pos_y = intToFixed((m_menu_index + 1) * 32 + 112);
     m_tank_pointer->setFlag(TSF_LIFE);
     m_tank_pointer->update(0);
     m_tank_pointer->clearFlag(TSF_LIFE);
@@ -59,22 +59,27 @@ void Menu::draw()
 
 void Menu::update(Uint32 dt)
 {
+    SDL_Rect previous_src = m_tank_pointer->src_rect;
     m_tank_pointer->speed = m_tank_pointer->default_speed;
     m_tank_pointer->stop = true;
     m_tank_pointer->update(dt);
+
+    // only the animation of the indicator changes the menu between key presses
+    if(!SDL_RectEquals(&previous_src, &m_tank_pointer->src_rect)) invalidate();
 }
 
 void Menu::eventProcess(SDL_Event *ev)
 {
     if(ev->type == SDL_KEYDOWN)
     {
+        invalidate();
         if(ev->key.keysym.sym == SDLK_UP)
         {
             m_menu_index--;
             if(m_menu_index < 0)
                 m_menu_index = m_menu_texts.size() - 1;
 
-            m_tank_pointer->pos_y = (m_menu_index + 1) * 32 + 110;
+            m_tank_pointer->pos_y = intToFixed((m_menu_index + 1) * 32 + 110);
         }
         else if(ev->key.keysym.sym == SDLK_DOWN)
         {
@@ -82,7 +87,7 @@ void Menu::eventProcess(SDL_Event *ev)
             if(m_menu_index >= m_menu_texts.size())
                 m_menu_index = 0;
 
-            m_tank_pointer->pos_y = (m_menu_index + 1) * 32 + 110;
+            m_tank_pointer->pos_y = intToFixed((m_menu_index + 1) * 32 + 110);
         }
         else if(ev->key.keysym.sym == SDLK_SPACE || ev->key.keysym.sym == SDLK_RETURN)
         {
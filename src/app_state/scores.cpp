@@ -33,6 +33,10 @@ Scores::Scores(std::vector<Player *> players, int level, bool game_over)
 
         if(player->score > m_max_score) m_max_score = player->score;
     }
+
+    // the next stage is loaded while the scores are counted
+    if(!m_game_over)
+        Engine::getEngine().getLevelPrefetcher()->prefetch(Game::followingLevel(m_level));
 }
 
 void Scores::draw()
@@ -85,12 +89,15 @@ void Scores::update(Uint32 dt)
         else if(m_score_counter < 200000) m_score_counter += 10000;
         else m_score_counter += 100000;
     }
+    if(m_score_counter_run) invalidate();
     for(auto player : m_players)
     {
+        SDL_Rect previous_src = player->src_rect;
         player->speed = player->default_speed;
         player->stop = true;
         player->setDirection(D_RIGHT);
         player->update(dt);
+        if(!SDL_RectEquals(&previous_src, &player->src_rect)) invalidate();
     }
 }
 
@@ -100,6 +107,7 @@ void Scores::eventProcess(SDL_Event *ev)
     {
         if(ev->key.keysym.sym == SDLK_RETURN)
         {
+            invalidate();
             if(m_score_counter > (1 << 30)) m_show_time = AppConfig::score_show_time + 1;
             else m_score_counter = (1 << 30) + 1;
         }
@@ -15,7 +15,7 @@ class Scores : public AppState
 public:
     Scores();
     /**
-     * Constructor called by Game after the gameplay ends
+     * Constructor called by Game after the gameplay ends. If the game goes on, the map of the next level is prefetched in the background.
      * @param players - container with all players who participated in the gameplay
      * @param level - last level number
      * @param game_over - variable telling whether the last level was lost
@@ -1,7 +1,10 @@
 #include "appconfig.h"
 
 string AppConfig::texture_path = "texture.png";
+string AppConfig::atlas_path = "atlas.bin";
 string AppConfig::levels_path = "levels/";
+string AppConfig::level_pack_path = "levels.pack";
+bool AppConfig::endless_levels = false;
 string AppConfig::font_name = "prstartk.ttf";
 string AppConfig::game_over_text = "GAME OVER";
 SDL_Rect AppConfig::map_rect = {0, 0, 26*16, 26*16};
@@ -54,6 +57,26 @@ unsigned AppConfig::bonus_blink_time = 350;
 unsigned AppConfig::player_reload_time = 120;
 int AppConfig::enemy_max_count_on_map = 4;
 double AppConfig::game_over_entry_speed = 0.13;
-double AppConfig::tank_default_speed = 0.08;
-double AppConfig::bullet_default_speed = 0.23;
+Fixed AppConfig::tank_default_speed = 5243; // 0.08 px/ms
+Fixed AppConfig::bullet_default_speed = 15073; // 0.23 px/ms
+unsigned AppConfig::simulation_tick_time = 16;
+unsigned AppConfig::ai_think_interval = 1;
+unsigned AppConfig::ai_budget = 0;
+unsigned AppConfig::ai_threads = 0;
+double AppConfig::present_frame_time = 0;
+bool AppConfig::show_pacing_stats = false;
+string AppConfig::capture_path = "";
+string AppConfig::capture_format = "ppm";
+string AppConfig::record_path = "";
+string AppConfig::replay_path = "";
+bool AppConfig::headless = false;
+string AppConfig::golden_path = "";
+bool AppConfig::update_golden = false;
+string AppConfig::golden_images_path = "";
+string AppConfig::diff_path = "";
+unsigned AppConfig::verify_frame_step = 1;
 bool AppConfig::show_enemy_target = false;
+bool AppConfig::show_render_stats = false;
+bool AppConfig::benchmark = false;
+unsigned AppConfig::benchmark_level_ticks = 5000;
+unsigned AppConfig::benchmark_tick_time = 16;
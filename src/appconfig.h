@@ -18,10 +18,22 @@ public:
      * Path to the object texture.
      */
     static string texture_path;
+    /**
+     * Path to the manifest of the texture atlas built by the @a atlaspacker tool; if it does not exist, @a texture_path is used with built-in sprite coordinates.
+     */
+    static string atlas_path;
     /**
      * Path to the directory with levels.
      */
     static string levels_path;
+    /**
+     * Path to the pack of compiled levels (command line option @a --pack); levels missing in the pack are read from @a levels_path.
+     */
+    static string level_pack_path;
+    /**
+     * Variable storing information about whether levels after the last one are generated (command line option @a --endless) instead of starting from the first level again.
+     */
+    static bool endless_levels;
     /**
      * Path to the font.
      */
@@ -111,7 +123,7 @@ public:
      */
     static unsigned player_reload_time;
     /**
-     * Maximum number of tanks on the map at one time.
+     * Maximum number of tanks on the map at one time (command line option @a --enemies).
      */
     static int enemy_max_count_on_map;
     /**
@@ -119,17 +131,97 @@ public:
      */
     static double game_over_entry_speed;
     /**
-     * Nominal speed of the tank.
+     * Nominal speed of the tank in pixels per millisecond, in the @a Fixed format.
+     */
+    static Fixed tank_default_speed;
+    /**
+     * Nominal speed of the bullet in pixels per millisecond, in the @a Fixed format.
+     */
+    static Fixed bullet_default_speed;
+    /**
+     * Duration of one simulation tick in milliseconds; the simulation runs with this fixed step independently of the display refresh.
+     */
+    static unsigned simulation_tick_time;
+    /**
+     * Number of simulation ticks between two decisions of the same enemy (command line option @a --ai-interval); decisions of different enemies are spread over these ticks. With the default 1 every enemy decides every tick as in the original game; larger values are meant for games with many enemies (@a --enemies).
+     */
+    static unsigned ai_think_interval;
+    /**
+     * Time of enemy decisions per simulation tick in microseconds (command line option @a --ai-budget); 0 means no limit. Ignored when a game is recorded or replayed.
+     */
+    static unsigned ai_budget;
+    /**
+     * Number of threads on which enemies make their decisions (command line option @a --ai-threads); 0 means one per processor core.
+     */
+    static unsigned ai_threads;
+    /**
+     * Target time between two presented frames in milliseconds (command line option @a --frame-time); 0 leaves the pacing to vertical sync.
+     */
+    static double present_frame_time;
+    /**
+     * Variable storing information about whether frame time statistics of the simulation and presentation are printed at exit (command line option @a --pacing-stats).
+     */
+    static bool show_pacing_stats;
+    /**
+     * Directory to which drawn frames are saved (command line option @a --capture); empty if frames are not captured.
+     */
+    static string capture_path;
+    /**
+     * Format of captured frames: "raw", "ppm" or "png" (command line option @a --capture-format).
+     */
+    static string capture_format;
+    /**
+     * File to which the input of the game is recorded (command line option @a --record); empty if the game is not recorded.
+     */
+    static string record_path;
+    /**
+     * Replay file played back instead of the keyboard input (command line option @a --replay); empty if no replay is played.
+     */
+    static string replay_path;
+    /**
+     * Variable storing information about whether the replay is verified without a window (command line option @a --headless).
+     */
+    static bool headless;
+    /**
+     * File with hashes of golden frames used in the headless mode (command line option @a --golden).
      */
-    static double tank_default_speed;
+    static string golden_path;
     /**
-     * Nominal speed of the bullet.
+     * Variable storing information about whether the golden file is rewritten with the frames of the replay instead of being verified (command line option @a --update-golden).
      */
-    static double bullet_default_speed;
+    static bool update_golden;
+    /**
+     * Directory of golden images, written with @a --update-golden and used for difference images (command line option @a --golden-images); empty if images are not used.
+     */
+    static string golden_images_path;
+    /**
+     * Directory to which frames that do not match and their difference images are written (command line option @a --diff-dir); empty if they are not written.
+     */
+    static string diff_path;
+    /**
+     * Every how many ticks a frame is verified in the headless mode (command line option @a --frame-step).
+     */
+    static unsigned verify_frame_step;
     /**
      * Variable storing information about whether showing enemy targets has been enabled.
      */
     static bool show_enemy_target;
+    /**
+     * Variable storing information about whether showing the number of draw calls and quads of the previous frame has been enabled.
+     */
+    static bool show_render_stats;
+    /**
+     * Variable storing information about whether the application was started in the tick benchmark mode (command line option @a --benchmark).
+     */
+    static bool benchmark;
+    /**
+     * Number of simulation ticks run on each level in the benchmark mode.
+     */
+    static unsigned benchmark_level_ticks;
+    /**
+     * Duration of one simulation tick in the benchmark mode, in milliseconds.
+     */
+    static unsigned benchmark_tick_time;
 };
 
 #endif // APPCONFIG_H
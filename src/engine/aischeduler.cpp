@@ -0,0 +1,52 @@
+#include "aischeduler.h"
+#include <algorithm>
+
+AIScheduler::AIScheduler()
+{
+    m_interval = 1;
+    m_budget = 0;
+    m_cursor = 0;
+    m_decisions = 0;
+    m_decision_time = 0;
+}
+
+void AIScheduler::configure(unsigned interval, unsigned budget)
+{
+    m_interval = interval > 0 ? interval : 1;
+    m_budget = static_cast<Uint64>(budget) * SDL_GetPerformanceFrequency() / 1000000;
+    if(budget > 0 && m_budget == 0) m_budget = 1;
+}
+
+void AIScheduler::reset()
+{
+    m_cursor = 0;
+    m_decisions = 0;
+}
+
+void AIScheduler::select(unsigned count, std::vector<unsigned> &agents)
+{
+    agents.clear();
+    m_decisions = 0;
+    if(count == 0) return;
+
+    Uint64 quota = (count + m_interval - 1) / m_interval;
+    if(m_budget > 0 && m_decision_time > 0) quota = std::max<Uint64>(1, std::min(quota, m_budget / m_decision_time));
+    while(m_decisions < quota)
+    {
+        // agents added or removed since the last tick only shift the turn of the others
+        if(m_cursor >= count) m_cursor = 0;
+        agents.push_back(m_cursor++);
+        m_decisions++;
+    }
+}
+
+void AIScheduler::reportTime(Uint64 elapsed)
+{
+    if(m_budget == 0 || m_decisions == 0) return;
+    m_decision_time = std::max<Uint64>(1, elapsed / m_decisions);
+}
+
+unsigned AIScheduler::lastDecisions() const
+{
+    return m_decisions;
+}
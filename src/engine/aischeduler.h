@@ -0,0 +1,71 @@
+#ifndef AISCHEDULER_H
+#define AISCHEDULER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Class spreads the decisions of computer-controlled agents over simulation ticks. Every tick only a share of the agents think, in turn,
+ * so each agent thinks once per @a interval ticks; a time budget additionally limits the number of decisions of a tick to those that
+ * fitted into it in the previous tick, and the remaining agents think in the next ticks. The time of the decisions per tick thus stays
+ * flat however many agents there are, while the cheap movement of all agents is still updated every tick by the caller.
+ *
+ * The scheduler only chooses the agents (@a select); the caller runs their decisions, possibly in parallel, and reports their time.
+ * Without a budget the order of decisions depends only on the number of ticks and agents, so recorded games replay identically.
+ */
+class AIScheduler
+{
+public:
+    AIScheduler();
+
+    /**
+     * Setting the limits of decisions
+     * @param interval - number of ticks between two decisions of the same agent, at least 1
+     * @param budget - time of decisions per tick in microseconds; 0 means no limit
+     */
+    void configure(unsigned interval, unsigned budget);
+    /**
+     * Starting the next decisions from the first agent, e.g. when a level starts
+     */
+    void reset();
+    /**
+     * Choosing the agents that think in this tick; at least one agent thinks in every tick, so the decisions go on however slow the machine is
+     * @param count - number of agents
+     * @param agents - indices of the chosen agents in the order of their turns
+     */
+    void select(unsigned count, std::vector<unsigned>& agents);
+    /**
+     * Reporting how long the decisions of the agents chosen by @a select took; used only with a budget
+     * @param elapsed - time of the decisions in performance counter units (@a SDL_GetPerformanceCounter)
+     */
+    void reportTime(Uint64 elapsed);
+    /**
+     * @return number of agents that thought in the last tick
+     */
+    unsigned lastDecisions() const;
+
+private:
+    /**
+     * Number of ticks between two decisions of the same agent
+     */
+    unsigned m_interval;
+    /**
+     * Time of decisions per tick in performance counter units; 0 means no limit
+     */
+    Uint64 m_budget;
+    /**
+     * Index of the agent thinking next
+     */
+    unsigned m_cursor;
+    /**
+     * Number of agents that thought in the last tick
+     */
+    unsigned m_decisions;
+    /**
+     * Time of one decision measured in the last tick in performance counter units; 0 before the first measurement
+     */
+    Uint64 m_decision_time;
+};
+
+#endif // AISCHEDULER_H
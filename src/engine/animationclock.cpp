@@ -0,0 +1,16 @@
+#include "animationclock.h"
+
+AnimationClock::AnimationClock()
+{
+    m_time = 0;
+}
+
+void AnimationClock::reset()
+{
+    m_time = 0;
+}
+
+void AnimationClock::update(Uint32 dt)
+{
+    m_time += dt;
+}
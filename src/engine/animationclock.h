@@ -0,0 +1,44 @@
+#ifndef ANIMATIONCLOCK_H
+#define ANIMATIONCLOCK_H
+
+#include "spriteconfig.h"
+
+/**
+ * @brief
+ * Clock shared by looped animations of objects that always animate in step, e.g. water tiles. Instead of advancing every object,
+ * the clock is advanced once per tick and the current frame is derived from it.
+ */
+class AnimationClock
+{
+public:
+    AnimationClock();
+
+    /**
+     * Restarting all animations from the first frame
+     */
+    void reset();
+    /**
+     * Advancing the clock
+     * @param dt - time since the last call in milliseconds
+     */
+    void update(Uint32 dt);
+    /**
+     * @param sprite - looped animation
+     * @return current frame of the animation
+     */
+    int frame(const SpriteData* sprite) const;
+
+private:
+    /**
+     * Time since the last @a reset in milliseconds
+     */
+    Uint32 m_time;
+};
+
+inline int AnimationClock::frame(const SpriteData *sprite) const
+{
+    if(sprite->frames_count <= 1 || sprite->frame_duration == 0) return 0;
+    return (m_time / sprite->frame_duration) % sprite->frames_count;
+}
+
+#endif // ANIMATIONCLOCK_H
@@ -1,9 +1,14 @@
 #include "engine.h"
+#include "../appconfig.h"
 
 Engine::Engine()
 {
     m_renderer = nullptr;
     m_sprite_config = nullptr;
+    m_input = nullptr;
+    m_level_pack = nullptr;
+    m_level_prefetcher = nullptr;
+    m_jobs = nullptr;
 }
 
 Engine &Engine::getEngine()
@@ -32,14 +37,30 @@ void Engine::initModules()
 {
     m_renderer = new Renderer;
     m_sprite_config = new SpriteConfig;
+    if(m_sprite_config->load(AppConfig::atlas_path))
+        AppConfig::texture_path = m_sprite_config->texturePath();
+    m_input = new InputQueue;
+    m_level_pack = new LevelPack;
+    m_level_pack->open(AppConfig::level_pack_path);
+    m_level_prefetcher = new LevelPrefetcher;
+    m_jobs = new JobSystem(AppConfig::ai_threads > 0 ? AppConfig::ai_threads : SDL_GetCPUCount());
 }
 
 void Engine::destroyModules()
 {
+    // the prefetcher goes first, its worker may still read the sprites and the level pack
+    delete m_level_prefetcher;
+    m_level_prefetcher = nullptr;
+    delete m_jobs;
+    m_jobs = nullptr;
     delete m_renderer;
     m_renderer = nullptr;
     delete m_sprite_config;
     m_sprite_config = nullptr;
+    delete m_input;
+    m_input = nullptr;
+    delete m_level_pack;
+    m_level_pack = nullptr;
 }
 
 Renderer *Engine::getRenderer() const
@@ -51,3 +72,23 @@ SpriteConfig *Engine::getSpriteConfig() const
 {
     return m_sprite_config;
 }
+
+InputQueue *Engine::getInput() const
+{
+    return m_input;
+}
+
+LevelPack *Engine::getLevelPack() const
+{
+    return m_level_pack;
+}
+
+LevelPrefetcher *Engine::getLevelPrefetcher() const
+{
+    return m_level_prefetcher;
+}
+
+JobSystem *Engine::getJobSystem() const
+{
+    return m_jobs;
+}
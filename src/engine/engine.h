@@ -1,8 +1,12 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include "inputqueue.h"
+#include "jobsystem.h"
 #include "renderer.h"
 #include "spriteconfig.h"
+#include "../level/levelpack.h"
+#include "../level/levelprefetcher.h"
 
 /**
  * @brief Class combines elements related to the program's operation
@@ -23,7 +27,8 @@ public:
      */
     static std::string intToString(int num);
     /**
-     * Function creates component objects of the engine
+     * Function creates component objects of the engine. If the atlas manifest @a AppConfig::atlas_path exists, sprites are taken from it
+     * and @a AppConfig::texture_path is set to the atlas image. The level pack @a AppConfig::level_pack_path is opened if it exists.
      */
     void initModules();
     /**
@@ -39,9 +44,29 @@ public:
      * @return pointer to SpriteConfig object storing information about textures
      */
     SpriteConfig* getSpriteConfig() const;
+    /**
+     * @return pointer to InputQueue object passing events and the keyboard state to the simulation thread
+     */
+    InputQueue* getInput() const;
+    /**
+     * @return pointer to LevelPack object with levels resident in memory; the pack is empty if its file could not be opened
+     */
+    LevelPack* getLevelPack() const;
+    /**
+     * @return pointer to LevelPrefetcher object building the map of the next level in the background
+     */
+    LevelPrefetcher* getLevelPrefetcher() const;
+    /**
+     * @return pointer to JobSystem object running batches of independent jobs, such as enemy decisions, on worker threads
+     */
+    JobSystem* getJobSystem() const;
 private:
     Renderer* m_renderer;
     SpriteConfig* m_sprite_config;
+    InputQueue* m_input;
+    LevelPack* m_level_pack;
+    LevelPrefetcher* m_level_prefetcher;
+    JobSystem* m_jobs;
 };
 
 #endif // ENGINE_H
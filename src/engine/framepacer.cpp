@@ -0,0 +1,73 @@
+#include "framepacer.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Remaining time in milliseconds below which the pacer spins instead of sleeping
+ */
+static const double spin_time = 2.0;
+/**
+ * Number of frames the pacer may fall behind before the schedule is moved to the current time
+ */
+static const Uint64 max_late_frames = 10;
+
+FramePacer::FramePacer()
+{
+    m_frequency = SDL_GetPerformanceFrequency();
+    m_period = 0;
+    start();
+}
+
+void FramePacer::setFrameTime(double milliseconds)
+{
+    m_period = static_cast<Uint64>(std::max(milliseconds, 0.0) * m_frequency / 1000.0);
+    start();
+}
+
+void FramePacer::start()
+{
+    m_last = SDL_GetPerformanceCounter();
+    m_next = m_last + m_period;
+    m_frames = 0;
+    m_sum = 0;
+    m_sum_squares = 0;
+    m_max_lateness = 0;
+}
+
+void FramePacer::wait()
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    if(m_period > 0)
+    {
+        Uint64 spin_ticks = static_cast<Uint64>(spin_time * m_frequency / 1000.0);
+        while(now < m_next)
+        {
+            Uint64 remaining = m_next - now;
+            if(remaining > spin_ticks)
+                SDL_Delay(static_cast<Uint32>((remaining - spin_ticks) * 1000 / m_frequency));
+            now = SDL_GetPerformanceCounter();
+        }
+
+        double lateness = (now - m_next) * 1000.0 / m_frequency;
+        m_max_lateness = std::max(m_max_lateness, lateness);
+        m_next += m_period;
+        if(now > m_next + max_late_frames * m_period)
+            m_next = now + m_period;
+    }
+
+    double interval = (now - m_last) * 1000.0 / m_frequency;
+    m_last = now;
+    m_frames++;
+    m_sum += interval;
+    m_sum_squares += interval * interval;
+}
+
+PacerStats FramePacer::stats() const
+{
+    PacerStats s;
+    s.frames = m_frames;
+    s.mean_frame_time = m_frames > 0 ? m_sum / m_frames : 0;
+    s.frame_time_deviation = m_frames > 0 ? std::sqrt(std::max(m_sum_squares / m_frames - s.mean_frame_time * s.mean_frame_time, 0.0)) : 0;
+    s.max_lateness = m_max_lateness;
+    return s;
+}
@@ -0,0 +1,95 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief
+ * Statistics of frames paced by @a FramePacer; times are in milliseconds
+ */
+struct PacerStats
+{
+    /**
+     * Number of measured frame intervals
+     */
+    unsigned frames;
+    /**
+     * Average time between the ends of two consecutive waits
+     */
+    double mean_frame_time;
+    /**
+     * Standard deviation of the time between two consecutive waits
+     */
+    double frame_time_deviation;
+    /**
+     * Largest delay of the end of a wait after its scheduled time
+     */
+    double max_lateness;
+};
+
+/**
+ * @brief
+ * Class keeps a loop running with a fixed frame time measured with the performance counter. The frame is scheduled on an absolute
+ * time line, so errors do not accumulate; the wait sleeps with SDL_Delay while the remaining time is long enough and spins for the rest,
+ * because SDL_Delay only has a millisecond granularity and may oversleep.
+ */
+class FramePacer
+{
+public:
+    FramePacer();
+
+    /**
+     * Setting the target frame time; the schedule is restarted
+     * @param milliseconds - time between two frames; 0 disables waiting
+     */
+    void setFrameTime(double milliseconds);
+    /**
+     * Restarting the schedule: the next frame is due one frame time from now. Statistics are cleared.
+     */
+    void start();
+    /**
+     * Waiting until the scheduled time of the next frame. If the loop is more than a few frames late (e.g. after the process was suspended),
+     * the schedule is moved to the current time instead of running the missed frames without waiting.
+     */
+    void wait();
+    /**
+     * @return statistics since the last @a start call
+     */
+    PacerStats stats() const;
+
+private:
+    /**
+     * Frequency of the performance counter
+     */
+    Uint64 m_frequency;
+    /**
+     * Frame time in performance counter ticks
+     */
+    Uint64 m_period;
+    /**
+     * Time of the next frame
+     */
+    Uint64 m_next;
+    /**
+     * Time at which the previous wait ended
+     */
+    Uint64 m_last;
+    /**
+     * Number of measured frame intervals
+     */
+    unsigned m_frames;
+    /**
+     * Sum of frame intervals in milliseconds
+     */
+    double m_sum;
+    /**
+     * Sum of squares of frame intervals in milliseconds
+     */
+    double m_sum_squares;
+    /**
+     * Largest lateness in milliseconds
+     */
+    double m_max_lateness;
+};
+
+#endif // FRAMEPACER_H
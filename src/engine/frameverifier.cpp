@@ -0,0 +1,179 @@
+#include "frameverifier.h"
+#include "framewriter.h"
+#include <cstdio>
+#include <iostream>
+
+FrameVerifier::FrameVerifier()
+{
+    m_update = false;
+    m_checked = 0;
+    m_failed = 0;
+}
+
+Uint64 FrameVerifier::hash(const Uint32 *pixels, int count)
+{
+    Uint64 h = 14695981039346656037ULL;
+    for(int i = 0; i < count; i++)
+    {
+        // bytes are taken from the value, so the hash does not depend on the byte order of the machine
+        for(int shift = 0; shift < 32; shift += 8)
+        {
+            h ^= (pixels[i] >> shift) & 0xff;
+            h *= 1099511628211ULL;
+        }
+    }
+    return h;
+}
+
+bool FrameVerifier::load(const std::string &path)
+{
+    FILE* file = fopen(path.c_str(), "r");
+    if(file == nullptr) return false;
+
+    char line[128];
+    unsigned tick;
+    unsigned long long value;
+    while(fgets(line, sizeof(line), file) != nullptr)
+    {
+        if(line[0] == '#') continue;
+        if(sscanf(line, "%u %llx", &tick, &value) == 2)
+            m_hashes[tick] = value;
+    }
+    fclose(file);
+    return true;
+}
+
+bool FrameVerifier::save(const std::string &path) const
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if(file == nullptr) return false;
+
+    fprintf(file, "# tick frame_hash\n");
+    for(auto& item : m_hashes)
+        fprintf(file, "%u %016llx\n", item.first, static_cast<unsigned long long>(item.second));
+    fclose(file);
+    return true;
+}
+
+void FrameVerifier::setUpdate(bool update)
+{
+    m_update = update;
+}
+
+void FrameVerifier::setImagesPath(const std::string &path)
+{
+    m_images_path = path;
+}
+
+void FrameVerifier::setDiffPath(const std::string &path)
+{
+    m_diff_path = path;
+}
+
+bool FrameVerifier::check(unsigned tick, const Uint32 *pixels, int width, int height)
+{
+    m_checked++;
+    m_checked_ticks.insert(tick);
+    Uint64 frame_hash = hash(pixels, width * height);
+
+    if(m_update)
+    {
+        m_hashes[tick] = frame_hash;
+        if(!m_images_path.empty())
+            FrameWriter::savePPM(framePath(m_images_path, tick, ".ppm"), pixels, width, height);
+        return true;
+    }
+
+    auto golden = m_hashes.find(tick);
+    if(golden != m_hashes.end() && golden->second == frame_hash) return true;
+
+    m_failed++;
+    if(golden == m_hashes.end())
+        std::cerr << "Tick " << tick << ": no golden frame" << std::endl;
+    else
+        std::cerr << "Tick " << tick << ": frame differs from the golden one" << std::endl;
+    if(!m_diff_path.empty())
+        dumpDifference(tick, pixels, width, height);
+    return false;
+}
+
+unsigned FrameVerifier::checkMissing()
+{
+    if(m_update) return 0;
+
+    unsigned missing = 0;
+    for(const auto& golden : m_hashes)
+    {
+        if(m_checked_ticks.count(golden.first)) continue;
+        std::cerr << "Tick " << golden.first << ": golden frame was not drawn" << std::endl;
+        missing++;
+    }
+    m_failed += missing;
+    return missing;
+}
+
+unsigned FrameVerifier::checkedFrames() const
+{
+    return m_checked;
+}
+
+unsigned FrameVerifier::failedFrames() const
+{
+    return m_failed;
+}
+
+std::string FrameVerifier::framePath(const std::string &directory, unsigned tick, const char *suffix)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "tick_%06u", tick);
+    std::string path = directory;
+    if(!path.empty() && path[path.size() - 1] != '/') path += '/';
+    return path + name + suffix;
+}
+
+bool FrameVerifier::loadPPM(const std::string &path, std::vector<Uint32> &pixels, int width, int height)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if(file == nullptr) return false;
+
+    int w, h, max_value;
+    if(fscanf(file, "P6 %d %d %d", &w, &h, &max_value) != 3 || w != width || h != height || max_value != 255)
+    {
+        fclose(file);
+        return false;
+    }
+    fgetc(file); // single whitespace after the header
+
+    std::vector<Uint8> bytes(width * height * 3);
+    bool read = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    if(!read) return false;
+
+    pixels.resize(width * height);
+    for(int i = 0; i < width * height; i++)
+        pixels[i] = 0xff000000 | bytes[i * 3] << 16 | bytes[i * 3 + 1] << 8 | bytes[i * 3 + 2];
+    return true;
+}
+
+void FrameVerifier::dumpDifference(unsigned tick, const Uint32 *pixels, int width, int height) const
+{
+    FrameWriter::savePPM(framePath(m_diff_path, tick, "_actual.ppm"), pixels, width, height);
+
+    std::vector<Uint32> golden;
+    if(m_images_path.empty() || !loadPPM(framePath(m_images_path, tick, ".ppm"), golden, width, height)) return;
+
+    // golden images do not keep the alpha channel, so only colors are compared
+    std::vector<Uint32> difference(width * height);
+    unsigned differing = 0;
+    for(int i = 0; i < width * height; i++)
+    {
+        if((pixels[i] & 0xffffff) != (golden[i] & 0xffffff))
+        {
+            difference[i] = 0xffff0000;
+            differing++;
+        }
+        else difference[i] = 0xff000000 | (pixels[i] >> 2 & 0x3f3f3f);
+    }
+    FrameWriter::savePPM(framePath(m_diff_path, tick, "_diff.ppm"), difference.data(), width, height);
+    std::cerr << "Tick " << tick << ": " << differing << " pixels differ" << std::endl;
+}
@@ -0,0 +1,134 @@
+#ifndef FRAMEVERIFIER_H
+#define FRAMEVERIFIER_H
+
+#include <SDL2/SDL.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Class compares frames drawn by the software backend with golden frames. A golden file stores a hash of every checked frame,
+ * golden images (optional) store the frames themselves, so that a failed frame can be dumped together with a per-pixel difference.
+ */
+class FrameVerifier
+{
+public:
+    FrameVerifier();
+
+    /**
+     * Computing the FNV-1a hash of pixels
+     * @param pixels - pixels in the ARGB8888 format
+     * @param count - number of pixels
+     * @return 64-bit hash
+     */
+    static Uint64 hash(const Uint32* pixels, int count);
+    /**
+     * Reading a golden file; each line contains a tick number and a hexadecimal hash, lines starting with '#' are skipped
+     * @param path - path of the file
+     * @return @a false if the file could not be read
+     */
+    bool load(const std::string& path);
+    /**
+     * Writing hashes of all checked frames as a golden file
+     * @param path - path of the file
+     * @return @a false if the file could not be written
+     */
+    bool save(const std::string& path) const;
+    /**
+     * Switching between verifying frames and updating the golden data with them
+     * @param update - @a true to store hashes (and images) of checked frames instead of comparing them
+     */
+    void setUpdate(bool update);
+    /**
+     * Setting the directory of golden images; empty path disables images
+     * @param path - existing directory
+     */
+    void setImagesPath(const std::string& path);
+    /**
+     * Setting the directory to which failed frames and their differences are written; empty path disables dumps
+     * @param path - existing directory
+     */
+    void setDiffPath(const std::string& path);
+    /**
+     * Checking a frame; in the update mode the frame becomes golden
+     * @param tick - number of the simulation tick of the frame
+     * @param pixels - pixels in the ARGB8888 format, row after row without padding
+     * @param width - width of the frame
+     * @param height - height of the frame
+     * @return @a false if the frame differs from the golden one or there is no golden hash for this tick
+     */
+    bool check(unsigned tick, const Uint32* pixels, int width, int height);
+    /**
+     * Counting golden frames whose ticks were never checked as failed, e.g. because the replay ended early or no frame was drawn at that tick;
+     * called once after the last @a check. Does nothing in the update mode.
+     * @return number of golden frames that were not checked
+     */
+    unsigned checkMissing();
+    /**
+     * @return number of checked frames
+     */
+    unsigned checkedFrames() const;
+    /**
+     * @return number of frames that did not match
+     */
+    unsigned failedFrames() const;
+
+private:
+    /**
+     * @param directory - directory of the file
+     * @param tick - number of the tick
+     * @param suffix - end of the file name
+     * @return path of a file with a frame of the given tick
+     */
+    static std::string framePath(const std::string& directory, unsigned tick, const char* suffix);
+    /**
+     * Reading a binary PPM file written by @a FrameWriter::savePPM
+     * @param path - path of the file
+     * @param pixels - read pixels in the ARGB8888 format
+     * @param width - expected width
+     * @param height - expected height
+     * @return @a false if the file could not be read or has other dimensions
+     */
+    static bool loadPPM(const std::string& path, std::vector<Uint32>& pixels, int width, int height);
+    /**
+     * Writing the failed frame and, if its golden image exists, a difference image: differing pixels are red, the others are a darkened copy of the frame
+     * @param tick - number of the tick
+     * @param pixels - pixels of the failed frame
+     * @param width - width of the frame
+     * @param height - height of the frame
+     */
+    void dumpDifference(unsigned tick, const Uint32* pixels, int width, int height) const;
+
+    /**
+     * Golden hashes, or hashes of checked frames in the update mode, indexed by tick
+     */
+    std::map<unsigned, Uint64> m_hashes;
+    /**
+     * Ticks of checked frames
+     */
+    std::set<unsigned> m_checked_ticks;
+    /**
+     * Variable telling whether checked frames update the golden data
+     */
+    bool m_update;
+    /**
+     * Directory of golden images
+     */
+    std::string m_images_path;
+    /**
+     * Directory of dumps of failed frames
+     */
+    std::string m_diff_path;
+    /**
+     * Number of checked frames
+     */
+    unsigned m_checked;
+    /**
+     * Number of frames that did not match
+     */
+    unsigned m_failed;
+};
+
+#endif // FRAMEVERIFIER_H
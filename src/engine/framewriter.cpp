@@ -0,0 +1,186 @@
+#include "framewriter.h"
+#include <SDL2/SDL_image.h>
+#include <iostream>
+
+/**
+ * Maximum number of frames waiting for saving
+ */
+static const unsigned max_queued_frames = 64;
+
+FrameWriter::FrameWriter()
+{
+    m_format = FF_PPM;
+    m_width = 0;
+    m_height = 0;
+    m_raw_file = nullptr;
+    m_stopping = false;
+    m_mutex = SDL_CreateMutex();
+    m_frame_queued = SDL_CreateCond();
+    m_frame_saved = SDL_CreateCond();
+    m_thread = nullptr;
+}
+
+FrameWriter::~FrameWriter()
+{
+    stop();
+    SDL_DestroyCond(m_frame_saved);
+    SDL_DestroyCond(m_frame_queued);
+    SDL_DestroyMutex(m_mutex);
+}
+
+bool FrameWriter::parseFormat(const std::string &name, FrameFormat *format)
+{
+    if(name == "raw") *format = FF_RAW;
+    else if(name == "ppm") *format = FF_PPM;
+    else if(name == "png") *format = FF_PNG;
+    else return false;
+    return true;
+}
+
+bool FrameWriter::start(const std::string &directory, FrameFormat format, int width, int height)
+{
+    stop();
+
+    m_directory = directory;
+    if(!m_directory.empty() && m_directory[m_directory.size() - 1] != '/') m_directory += '/';
+    m_format = format;
+    m_width = width;
+    m_height = height;
+    m_stopping = false;
+
+    if(m_format == FF_RAW)
+    {
+        m_raw_file = fopen((m_directory + "frames.rgba").c_str(), "wb");
+        if(m_raw_file == nullptr)
+        {
+            std::cerr << "Cannot create " << m_directory << "frames.rgba" << std::endl;
+            return false;
+        }
+    }
+
+    m_thread = SDL_CreateThread(writerThread, "frame writer", this);
+    return m_thread != nullptr;
+}
+
+void FrameWriter::write(const Uint32 *pixels)
+{
+    if(m_thread == nullptr) return;
+
+    SDL_LockMutex(m_mutex);
+    while(m_queue.size() >= max_queued_frames)
+        SDL_CondWait(m_frame_saved, m_mutex);
+
+    if(m_free_frames.empty())
+        m_queue.push_back(std::vector<Uint32>(pixels, pixels + m_width * m_height));
+    else
+    {
+        m_queue.push_back(std::vector<Uint32>());
+        m_queue.back().swap(m_free_frames.back());
+        m_free_frames.pop_back();
+        m_queue.back().assign(pixels, pixels + m_width * m_height);
+    }
+    SDL_CondSignal(m_frame_queued);
+    SDL_UnlockMutex(m_mutex);
+}
+
+void FrameWriter::stop()
+{
+    if(m_thread != nullptr)
+    {
+        SDL_LockMutex(m_mutex);
+        m_stopping = true;
+        SDL_CondSignal(m_frame_queued);
+        SDL_UnlockMutex(m_mutex);
+
+        SDL_WaitThread(m_thread, nullptr);
+        m_thread = nullptr;
+    }
+    if(m_raw_file != nullptr)
+    {
+        fclose(m_raw_file);
+        m_raw_file = nullptr;
+    }
+}
+
+int FrameWriter::writerThread(void *writer)
+{
+    static_cast<FrameWriter*>(writer)->writerLoop();
+    return 0;
+}
+
+void FrameWriter::writerLoop()
+{
+    std::vector<Uint32> frame;
+    unsigned number = 0;
+    while(true)
+    {
+        SDL_LockMutex(m_mutex);
+        while(m_queue.empty() && !m_stopping)
+            SDL_CondWait(m_frame_queued, m_mutex);
+        if(m_queue.empty())
+        {
+            SDL_UnlockMutex(m_mutex);
+            break;
+        }
+        if(!frame.empty()) m_free_frames.push_back(std::move(frame));
+        frame.swap(m_queue.front());
+        m_queue.pop_front();
+        SDL_CondSignal(m_frame_saved);
+        SDL_UnlockMutex(m_mutex);
+
+        saveFrame(frame, number++);
+    }
+}
+
+void FrameWriter::saveFrame(const std::vector<Uint32> &frame, unsigned number)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "frame_%06u", number);
+
+    if(m_format == FF_PNG)
+    {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceFrom(const_cast<Uint32*>(frame.data()), m_width, m_height, 32, m_width * 4,
+                                                        0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+        if(surface == nullptr) return;
+        IMG_SavePNG(surface, (m_directory + name + ".png").c_str());
+        SDL_FreeSurface(surface);
+        return;
+    }
+
+    if(m_format == FF_PPM)
+    {
+        savePPM(m_directory + name + ".ppm", frame.data(), m_width, m_height);
+        return;
+    }
+
+    // ARGB8888 pixels are written as bytes in the order R, G, B, A
+    m_bytes.resize(frame.size() * 4);
+    Uint8* out = m_bytes.data();
+    for(Uint32 pixel : frame)
+    {
+        *out++ = pixel >> 16;
+        *out++ = pixel >> 8;
+        *out++ = pixel;
+        *out++ = pixel >> 24;
+    }
+    fwrite(m_bytes.data(), 1, m_bytes.size(), m_raw_file);
+}
+
+bool FrameWriter::savePPM(const std::string &path, const Uint32 *pixels, int width, int height)
+{
+    std::vector<Uint8> bytes(width * height * 3);
+    Uint8* out = bytes.data();
+    for(int i = 0; i < width * height; i++)
+    {
+        *out++ = pixels[i] >> 16;
+        *out++ = pixels[i] >> 8;
+        *out++ = pixels[i];
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if(file == nullptr) return false;
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    return written;
+}
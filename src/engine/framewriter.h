@@ -0,0 +1,139 @@
+#ifndef FRAMEWRITER_H
+#define FRAMEWRITER_H
+
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * File formats of saved frames
+ */
+enum FrameFormat
+{
+    FF_RAW, ///< all frames appended to a single file frames.rgba, 4 bytes per pixel in the order R, G, B, A
+    FF_PPM, ///< a binary PPM file per frame
+    FF_PNG  ///< a PNG file per frame
+};
+
+/**
+ * @brief
+ * Class saves frames on a separate thread, so encoding and disk writes do not slow down the thread producing frames.
+ * The number of frames waiting for saving is limited; when the limit is reached, @a write waits.
+ */
+class FrameWriter
+{
+public:
+    FrameWriter();
+    ~FrameWriter();
+
+    /**
+     * Converting the name of a format used on the command line
+     * @param name - "raw", "ppm" or "png"
+     * @param format - the recognized format
+     * @return @a false if the name is unknown
+     */
+    static bool parseFormat(const std::string& name, FrameFormat* format);
+    /**
+     * Saving a frame as a binary PPM file
+     * @param path - path of the file
+     * @param pixels - pixels in the ARGB8888 format, row after row without padding
+     * @param width - width of the frame
+     * @param height - height of the frame
+     * @return @a false if the file could not be written
+     */
+    static bool savePPM(const std::string& path, const Uint32* pixels, int width, int height);
+    /**
+     * Starting the writing thread
+     * @param directory - existing directory for the saved files
+     * @param format - file format
+     * @param width - width of frames in pixels
+     * @param height - height of frames in pixels
+     * @return @a false if the output could not be opened or the thread could not be started
+     */
+    bool start(const std::string& directory, FrameFormat format, int width, int height);
+    /**
+     * Queueing a copy of a frame for saving
+     * @param pixels - pixels in the ARGB8888 format, row after row without padding
+     */
+    void write(const Uint32* pixels);
+    /**
+     * Saving all queued frames and stopping the writing thread
+     */
+    void stop();
+
+private:
+    /**
+     * The function of the writing thread
+     * @param writer - pointer to the writer
+     * @return thread exit code
+     */
+    static int writerThread(void* writer);
+    /**
+     * The loop of the writing thread
+     */
+    void writerLoop();
+    /**
+     * Saving a single frame
+     * @param frame - pixels of the frame
+     * @param number - number of the frame, used in file names
+     */
+    void saveFrame(const std::vector<Uint32>& frame, unsigned number);
+
+    /**
+     * Directory of the saved files
+     */
+    std::string m_directory;
+    /**
+     * File format
+     */
+    FrameFormat m_format;
+    /**
+     * Width of frames
+     */
+    int m_width;
+    /**
+     * Height of frames
+     */
+    int m_height;
+    /**
+     * Output file of the raw format
+     */
+    FILE* m_raw_file;
+    /**
+     * Buffer for converting pixels to bytes of the output
+     */
+    std::vector<Uint8> m_bytes;
+    /**
+     * Frames waiting for saving
+     */
+    std::deque<std::vector<Uint32>> m_queue;
+    /**
+     * Saved frames whose memory is reused for the next ones
+     */
+    std::vector<std::vector<Uint32>> m_free_frames;
+    /**
+     * Variable telling the writing thread to finish after saving the queue
+     */
+    bool m_stopping;
+    /**
+     * Mutex protecting the queue, the free frames and @a m_stopping
+     */
+    SDL_mutex* m_mutex;
+    /**
+     * Condition signaled when a frame is queued or writing is stopped
+     */
+    SDL_cond* m_frame_queued;
+    /**
+     * Condition signaled when a frame is saved
+     */
+    SDL_cond* m_frame_saved;
+    /**
+     * The writing thread; @a nullptr if writing is not running
+     */
+    SDL_Thread* m_thread;
+};
+
+#endif // FRAMEWRITER_H
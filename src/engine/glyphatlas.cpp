@@ -0,0 +1,112 @@
+#include "glyphatlas.h"
+#include "../appconfig.h"
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+
+GlyphAtlas::GlyphAtlas()
+{
+    m_surface = nullptr;
+    m_height = 0;
+    for(int i = 0; i < chars_count; i++)
+    {
+        m_glyphs[i] = {0, 0, 0, 0};
+        m_advance[i] = 0;
+    }
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    if(m_surface != nullptr)
+        SDL_FreeSurface(m_surface);
+}
+
+int GlyphAtlas::fontIndex(int font_number)
+{
+    if(font_number == 2) return 1;
+    if(font_number == 3) return 2;
+    return 0;
+}
+
+bool GlyphAtlas::load(int font_index)
+{
+    const int point_sizes[fonts_count] = {28, 14, 10};
+    const int max_width = 512;
+    TTF_Font* font = TTF_OpenFont(AppConfig::font_name.c_str(), point_sizes[font_index]);
+    if(font == nullptr) return false;
+
+    SDL_Surface* glyph_surfaces[chars_count];
+    int x = 0, y = 0, atlas_width = 0;
+    m_height = TTF_FontHeight(font);
+
+    // rendering each character separately and placing it in rows of the atlas
+    for(int i = 0; i < chars_count; i++)
+    {
+        char text[2] = {static_cast<char>(first_char + i), 0};
+        int minx, maxx, miny, maxy;
+        if(TTF_GlyphMetrics(font, text[0], &minx, &maxx, &miny, &maxy, &m_advance[i]) != 0)
+            m_advance[i] = 0;
+
+        glyph_surfaces[i] = TTF_RenderText_Solid(font, text, {255, 255, 255, 255});
+        if(glyph_surfaces[i] == nullptr)
+        {
+            m_glyphs[i] = {0, 0, 0, 0};
+            continue;
+        }
+
+        if(x + glyph_surfaces[i]->w > max_width)
+        {
+            x = 0;
+            y += m_height;
+        }
+        m_glyphs[i] = {x, y, glyph_surfaces[i]->w, glyph_surfaces[i]->h};
+        x += glyph_surfaces[i]->w;
+        atlas_width = std::max(atlas_width, x);
+    }
+    TTF_CloseFont(font);
+
+    if(m_surface != nullptr)
+        SDL_FreeSurface(m_surface);
+    m_surface = SDL_CreateRGBSurface(0, std::max(atlas_width, 1), y + m_height, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+    if(m_surface != nullptr)
+        SDL_FillRect(m_surface, NULL, 0);
+
+    for(int i = 0; i < chars_count; i++)
+    {
+        if(glyph_surfaces[i] == nullptr) continue;
+        if(m_surface != nullptr)
+            SDL_BlitSurface(glyph_surfaces[i], NULL, m_surface, &m_glyphs[i]);
+        SDL_FreeSurface(glyph_surfaces[i]);
+    }
+    return m_surface != nullptr;
+}
+
+SDL_Surface *GlyphAtlas::surface() const
+{
+    return m_surface;
+}
+
+const SDL_Rect *GlyphAtlas::glyph(char c) const
+{
+    int index = c - first_char;
+    if(index < 0 || index >= chars_count) return nullptr;
+    return &m_glyphs[index];
+}
+
+int GlyphAtlas::advance(char c) const
+{
+    int index = c - first_char;
+    if(index < 0 || index >= chars_count) return 0;
+    return m_advance[index];
+}
+
+SDL_Point GlyphAtlas::textOrigin(SDL_Point start, const char *text, unsigned length) const
+{
+    int text_width = 0;
+    for(unsigned i = 0; i < length; i++)
+        text_width += advance(text[i]);
+
+    SDL_Point origin = start;
+    if(start.x < 0) origin.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - text_width)/2;
+    if(start.y < 0) origin.y = (AppConfig::map_rect.h - m_height)/2;
+    return origin;
+}
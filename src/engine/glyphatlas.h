@@ -0,0 +1,83 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief
+ * Class storing all printable ASCII characters of one font size rendered once into a single surface
+ */
+class GlyphAtlas
+{
+public:
+    /**
+     * Code of the first character stored in the atlas
+     */
+    static const int first_char = 32;
+    /**
+     * Number of characters stored in the atlas (codes 32 - 126)
+     */
+    static const int chars_count = 95;
+    /**
+     * Number of font sizes used by the game
+     */
+    static const int fonts_count = 3;
+
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    /**
+     * Choosing the atlas index for the font number used by @a Renderer::drawText
+     * @param font_number - font number: 1, 2 or 3
+     * @return index from 0 to @a fonts_count - 1; other numbers give the first font
+     */
+    static int fontIndex(int font_number);
+    /**
+     * Rendering all characters of the font @a AppConfig::font_name into the atlas
+     * @param font_index - index of the font size: 0 - 28 pt, 1 - 14 pt, 2 - 10 pt
+     * @return @a true if the atlas was created
+     */
+    bool load(int font_index);
+    /**
+     * @return surface with white characters on a transparent background in the ARGB8888 format, @a nullptr if the atlas was not loaded
+     */
+    SDL_Surface* surface() const;
+    /**
+     * @param c - character
+     * @return rectangle of the character in the atlas; @a nullptr for characters outside the atlas
+     */
+    const SDL_Rect* glyph(char c) const;
+    /**
+     * @param c - character
+     * @return horizontal distance between the beginning of the character and the beginning of the next one
+     */
+    int advance(char c) const;
+    /**
+     * Computing the starting point of a text drawn with this font
+     * @param start - requested starting point; negative value of either coordinate results in centering the text on that axis
+     * @param text - text, not terminated with zero
+     * @param length - number of characters
+     * @return position of the upper left corner of the first character
+     */
+    SDL_Point textOrigin(SDL_Point start, const char* text, unsigned length) const;
+
+private:
+    /**
+     * Surface with all characters
+     */
+    SDL_Surface* m_surface;
+    /**
+     * Position and dimensions of each character in the atlas
+     */
+    SDL_Rect m_glyphs[chars_count];
+    /**
+     * Horizontal distance between the beginning of a character and the beginning of the next one
+     */
+    int m_advance[chars_count];
+    /**
+     * Height of a line of text
+     */
+    int m_height;
+};
+
+#endif // GLYPHATLAS_H
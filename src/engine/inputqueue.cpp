@@ -0,0 +1,53 @@
+#include "inputqueue.h"
+#include <algorithm>
+#include <cstring>
+
+InputQueue::InputQueue()
+{
+    m_mutex = SDL_CreateMutex();
+    m_stored_keys.assign(SDL_NUM_SCANCODES, 0);
+    m_keys.assign(SDL_NUM_SCANCODES, 0);
+}
+
+InputQueue::~InputQueue()
+{
+    if(m_mutex != nullptr)
+        SDL_DestroyMutex(m_mutex);
+}
+
+void InputQueue::push(const SDL_Event &event)
+{
+    SDL_LockMutex(m_mutex);
+    m_events.push_back(event);
+    SDL_UnlockMutex(m_mutex);
+}
+
+void InputQueue::storeKeyboardState()
+{
+    int count = 0;
+    const Uint8* key_state = SDL_GetKeyboardState(&count);
+    if(key_state == nullptr) return;
+
+    SDL_LockMutex(m_mutex);
+    memcpy(m_stored_keys.data(), key_state, std::min<int>(count, SDL_NUM_SCANCODES));
+    SDL_UnlockMutex(m_mutex);
+}
+
+void InputQueue::takeEvents(std::vector<SDL_Event> &events)
+{
+    events.clear();
+    SDL_LockMutex(m_mutex);
+    events.swap(m_events);
+    m_keys = m_stored_keys;
+    SDL_UnlockMutex(m_mutex);
+}
+
+void InputQueue::setKeyboardState(const Uint8 *keys)
+{
+    m_keys.assign(keys, keys + SDL_NUM_SCANCODES);
+}
+
+const Uint8 *InputQueue::keyboardState() const
+{
+    return m_keys.data();
+}
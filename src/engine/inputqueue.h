@@ -0,0 +1,61 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Class passes input from the thread handling window events to the simulation thread. Events are queued
+ * and the keyboard state is copied, so the simulation never reads SDL input state directly.
+ */
+class InputQueue
+{
+public:
+    InputQueue();
+    ~InputQueue();
+
+    /**
+     * Adding an event to the queue; called by the thread handling window events
+     * @param event - event to pass
+     */
+    void push(const SDL_Event& event);
+    /**
+     * Copying the current SDL keyboard state; called by the thread handling window events after polling the events
+     */
+    void storeKeyboardState();
+    /**
+     * Moving all queued events to @a events and taking the last stored keyboard state; called by the simulation thread once per tick
+     * @param events - container receiving the events, previous content is removed
+     */
+    void takeEvents(std::vector<SDL_Event>& events);
+    /**
+     * Replacing the keyboard state seen by the simulation, e.g. with a state read from a replay; called by the simulation thread after @a takeEvents
+     * @param keys - keyboard state indexed by SDL_Scancode
+     */
+    void setKeyboardState(const Uint8* keys);
+    /**
+     * @return keyboard state indexed by SDL_Scancode, taken by the last @a takeEvents call
+     */
+    const Uint8* keyboardState() const;
+
+private:
+    /**
+     * Mutex protecting @a m_events and @a m_stored_keys
+     */
+    SDL_mutex* m_mutex;
+    /**
+     * Events waiting for the simulation thread
+     */
+    std::vector<SDL_Event> m_events;
+    /**
+     * Keyboard state copied by the thread handling window events
+     */
+    std::vector<Uint8> m_stored_keys;
+    /**
+     * Keyboard state seen by the simulation
+     */
+    std::vector<Uint8> m_keys;
+};
+
+#endif // INPUTQUEUE_H
@@ -0,0 +1,110 @@
+#include "jobsystem.h"
+
+JobSystem::JobSystem(unsigned threads)
+{
+    m_batch = 0;
+    m_open = false;
+    m_joined = 0;
+    m_quit = false;
+    m_job = nullptr;
+    m_data = nullptr;
+    m_count = 0;
+    SDL_AtomicSet(&m_next, 0);
+
+    m_mutex = SDL_CreateMutex();
+    m_start = SDL_CreateCond();
+    m_finish = SDL_CreateCond();
+    if(m_mutex == nullptr || m_start == nullptr || m_finish == nullptr) return;
+
+    // the calling thread is one of the threads working on a batch
+    for(unsigned i = 1; i < threads; i++)
+    {
+        SDL_Thread* thread = SDL_CreateThread(workerThread, "jobs", this);
+        if(thread != nullptr) m_threads.push_back(thread);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    if(m_mutex != nullptr)
+    {
+        SDL_LockMutex(m_mutex);
+        m_quit = true;
+        SDL_CondBroadcast(m_start);
+        SDL_UnlockMutex(m_mutex);
+    }
+    for(SDL_Thread* thread : m_threads)
+        SDL_WaitThread(thread, nullptr);
+
+    if(m_finish != nullptr) SDL_DestroyCond(m_finish);
+    if(m_start != nullptr) SDL_DestroyCond(m_start);
+    if(m_mutex != nullptr) SDL_DestroyMutex(m_mutex);
+}
+
+void JobSystem::run(unsigned count, Job job, void *data)
+{
+    if(count == 0) return;
+    if(m_threads.empty() || count < min_parallel_jobs)
+    {
+        for(unsigned i = 0; i < count; i++) job(i, data);
+        return;
+    }
+
+    SDL_LockMutex(m_mutex);
+    m_job = job;
+    m_data = data;
+    m_count = count;
+    SDL_AtomicSet(&m_next, 0);
+    m_batch++;
+    m_open = true;
+    SDL_CondBroadcast(m_start);
+    SDL_UnlockMutex(m_mutex);
+
+    work();
+
+    // every job has been taken; the batch is finished when the workers that took some have left it, the others do not join it any more
+    SDL_LockMutex(m_mutex);
+    m_open = false;
+    while(m_joined > 0)
+        SDL_CondWait(m_finish, m_mutex);
+    SDL_UnlockMutex(m_mutex);
+}
+
+unsigned JobSystem::threads() const
+{
+    return m_threads.size() + 1;
+}
+
+int JobSystem::workerThread(void *jobs)
+{
+    JobSystem* system = static_cast<JobSystem*>(jobs);
+    unsigned batch = 0;
+    SDL_LockMutex(system->m_mutex);
+    for(;;)
+    {
+        while(!system->m_quit && system->m_batch == batch)
+            SDL_CondWait(system->m_start, system->m_mutex);
+        if(system->m_quit) break;
+        batch = system->m_batch;
+        if(!system->m_open) continue; // woken too late, the jobs are done
+        system->m_joined++;
+        SDL_UnlockMutex(system->m_mutex);
+
+        system->work();
+
+        SDL_LockMutex(system->m_mutex);
+        if(--system->m_joined == 0) SDL_CondSignal(system->m_finish);
+    }
+    SDL_UnlockMutex(system->m_mutex);
+    return 0;
+}
+
+void JobSystem::work()
+{
+    for(;;)
+    {
+        unsigned index = SDL_AtomicAdd(&m_next, 1);
+        if(index >= m_count) break;
+        m_job(index, m_data);
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Class runs independent jobs of one batch on a pool of worker threads. The calling thread works on the batch too and returns only when
+ * all jobs have finished, so the batch behaves like an ordinary loop whose iterations run in any order and on any thread; the jobs must
+ * not write anything shared. The calling thread does not wait for workers that wake up too late to take a job, and batches smaller than
+ * @a min_parallel_jobs, as well as all batches without workers, e.g. on a single core, simply run on the calling thread.
+ */
+class JobSystem
+{
+public:
+    /**
+     * Function of a job
+     * @param index - index of the job in the batch
+     * @param data - data of the batch
+     */
+    typedef void (*Job)(unsigned index, void* data);
+    /**
+     * Smallest batch run on the workers; waking a worker takes longer than several short jobs, such as decisions of enemies
+     */
+    static const unsigned min_parallel_jobs = 16;
+
+    /**
+     * Starting the worker threads
+     * @param threads - number of threads working on a batch together with the calling thread; at most 1 means no workers
+     */
+    JobSystem(unsigned threads);
+    /**
+     * Stopping and waiting for the worker threads
+     */
+    ~JobSystem();
+
+    /**
+     * Running a batch of jobs and waiting for all of them
+     * @param count - number of jobs
+     * @param job - function called with the index of each job
+     * @param data - data passed to every job
+     */
+    void run(unsigned count, Job job, void* data);
+    /**
+     * Running a batch of jobs given by a function object, e.g. a lambda, called with the index of each job
+     * @param count - number of jobs
+     * @param job - function object
+     */
+    template<typename Function>
+    void run(unsigned count, Function& job);
+    /**
+     * @return number of threads working on a batch, including the calling thread
+     */
+    unsigned threads() const;
+
+private:
+    /**
+     * Function of the worker threads
+     * @param jobs - pointer to the @a JobSystem object
+     * @return 0
+     */
+    static int workerThread(void* jobs);
+    /**
+     * Taking jobs of the current batch until there are none left
+     */
+    void work();
+    template<typename Function>
+    static void callFunction(unsigned index, void* function);
+
+    std::vector<SDL_Thread*> m_threads;
+    SDL_mutex* m_mutex;
+    /**
+     * Signalled when a batch starts or the workers are stopped
+     */
+    SDL_cond* m_start;
+    /**
+     * Signalled when the last worker working on the batch has left it
+     */
+    SDL_cond* m_finish;
+    /**
+     * Number of the current batch; a worker looks at a batch once when the number changes
+     */
+    unsigned m_batch;
+    /**
+     * Whether workers may still join the current batch; it is closed when the calling thread has found no job left
+     */
+    bool m_open;
+    /**
+     * Number of workers working on the current batch
+     */
+    unsigned m_joined;
+    bool m_quit;
+
+    Job m_job;
+    void* m_data;
+    unsigned m_count;
+    /**
+     * Index of the next job to take
+     */
+    SDL_atomic_t m_next;
+};
+
+template<typename Function>
+void JobSystem::run(unsigned count, Function& job)
+{
+    run(count, &callFunction<Function>, &job);
+}
+
+template<typename Function>
+void JobSystem::callFunction(unsigned index, void* function)
+{
+    (*static_cast<Function*>(function))(index);
+}
+
+#endif // JOBSYSTEM_H
@@ -0,0 +1,24 @@
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include "rendercommandbuffer.h"
+
+/**
+ * @brief
+ * Interface of classes executing recorded drawing commands
+ */
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() {}
+
+    /**
+     * Drawing a whole frame described by sorted commands
+     * @param commands - command buffer of the frame
+     * @param alpha - progress between the previous and the current simulation tick, from 0 to 1; moving sprites are drawn at
+     * the interpolated position
+     */
+    virtual void execute(const RenderCommandBuffer& commands, float alpha) = 0;
+};
+
+#endif // RENDERBACKEND_H
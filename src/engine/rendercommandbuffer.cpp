@@ -0,0 +1,122 @@
+#include "rendercommandbuffer.h"
+#include <algorithm>
+
+RenderCommandBuffer::RenderCommandBuffer()
+{
+    m_terrain_columns = 0;
+    m_terrain_rows = 0;
+    m_time = 0;
+}
+
+void RenderCommandBuffer::clear()
+{
+    m_commands.clear();
+    m_text_pool.clear();
+}
+
+void RenderCommandBuffer::addSprite(RenderLayer layer, const SDL_Rect &texture_src, const SDL_Rect &window_dest, SDL_Point motion)
+{
+    RenderCommand& command = add(layer, RC_SPRITE);
+    command.src = texture_src;
+    command.dest = window_dest;
+    command.motion = motion;
+    command.color = {255, 255, 255, 255};
+}
+
+void RenderCommandBuffer::addRect(RenderLayer layer, const SDL_Rect &rect, SDL_Color rect_color, bool fill)
+{
+    RenderCommand& command = add(layer, fill ? RC_FILL_RECT : RC_RECT);
+    command.src = {0, 0, 0, 0};
+    command.dest = rect;
+    command.color = rect_color;
+}
+
+void RenderCommandBuffer::addText(RenderLayer layer, SDL_Point start, const std::string &text, SDL_Color text_color, int font_size)
+{
+    RenderCommand& command = add(layer, RC_TEXT);
+    command.dest = {start.x, start.y, 0, 0};
+    command.color = text_color;
+    command.text.font_size = font_size;
+    command.text.offset = m_text_pool.size();
+    command.text.length = text.size();
+    m_text_pool += text;
+}
+
+void RenderCommandBuffer::addTerrain(RenderLayer layer, const SDL_Rect &dest, SDL_Point motion, const SDL_Rect &chunks)
+{
+    RenderCommand& command = add(layer, RC_TERRAIN);
+    command.src = chunks;
+    command.dest = dest;
+    command.motion = motion;
+    command.color = {255, 255, 255, 255};
+}
+
+void RenderCommandBuffer::setTerrain(int columns, int rows, const std::vector<TerrainChunk> &chunks, const SDL_Rect &range)
+{
+    if(columns != m_terrain_columns || rows != m_terrain_rows || chunks.size() != m_terrain_chunks.size())
+    {
+        m_terrain_columns = columns;
+        m_terrain_rows = rows;
+        m_terrain_chunks.assign(chunks.size(), TerrainChunk{std::vector<SDL_Rect>(), 0, 0});
+    }
+
+    int chunk_columns = (columns + terrain_chunk_size - 1) / terrain_chunk_size;
+    for(int y = range.y; y < range.y + range.h; y++)
+        for(int x = range.x; x < range.x + range.w; x++)
+        {
+            const TerrainChunk& chunk = chunks[y * chunk_columns + x];
+            TerrainChunk& copy = m_terrain_chunks[y * chunk_columns + x];
+            if(copy.version != chunk.version) copy = chunk;
+        }
+}
+
+void RenderCommandBuffer::sort()
+{
+    // keys are unique, so the order of commands in the same layer does not change
+    std::sort(m_commands.begin(), m_commands.end(), [](const RenderCommand& a, const RenderCommand& b) { return a.key < b.key; });
+}
+
+void RenderCommandBuffer::setTime(Uint64 time)
+{
+    m_time = time;
+}
+
+const std::vector<RenderCommand> &RenderCommandBuffer::commands() const
+{
+    return m_commands;
+}
+
+const char *RenderCommandBuffer::text(const RenderCommand &command) const
+{
+    return m_text_pool.data() + command.text.offset;
+}
+
+int RenderCommandBuffer::terrainColumns() const
+{
+    return m_terrain_columns;
+}
+
+int RenderCommandBuffer::terrainRows() const
+{
+    return m_terrain_rows;
+}
+
+const std::vector<TerrainChunk> &RenderCommandBuffer::terrainChunks() const
+{
+    return m_terrain_chunks;
+}
+
+Uint64 RenderCommandBuffer::time() const
+{
+    return m_time;
+}
+
+RenderCommand &RenderCommandBuffer::add(RenderLayer layer, RenderCommandType type)
+{
+    m_commands.push_back(RenderCommand());
+    RenderCommand& command = m_commands.back();
+    command.key = static_cast<Uint32>(layer) << 24 | (m_commands.size() & 0xffffff);
+    command.type = type;
+    command.motion = {0, 0};
+    return command;
+}
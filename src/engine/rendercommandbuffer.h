@@ -0,0 +1,250 @@
+#ifndef RENDERCOMMANDBUFFER_H
+#define RENDERCOMMANDBUFFER_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Drawing layers; commands of a lower layer are always executed before commands of a higher one,
+ * commands of the same layer are executed in the order of recording
+ */
+enum RenderLayer
+{
+    RL_BACKGROUND,
+    RL_TERRAIN,
+    RL_WATER,
+    RL_TANKS,
+    RL_BUSHES,
+    RL_ITEMS,
+    RL_STATUS,
+    RL_TEXT
+};
+
+/**
+ * @param layer - drawing layer
+ * @return @a true for the layers showing the map, which are moved by the camera and clipped to the map area
+ */
+inline bool isWorldLayer(RenderLayer layer)
+{
+    return layer >= RL_TERRAIN && layer <= RL_ITEMS;
+}
+
+/**
+ * @brief
+ * Types of drawing commands
+ */
+enum RenderCommandType
+{
+    RC_SPRITE,
+    RC_RECT,
+    RC_FILL_RECT,
+    RC_TEXT,
+    RC_TERRAIN
+};
+
+/**
+ * @brief
+ * Single drawing command
+ */
+struct RenderCommand
+{
+    /**
+     * @return drawing layer of the command
+     */
+    RenderLayer layer() const { return static_cast<RenderLayer>(key >> 24); }
+
+    /**
+     * Sorting key: layer in the highest byte, sequence number of the command in the remaining bytes
+     */
+    Uint32 key;
+    /**
+     * Type of the command
+     */
+    RenderCommandType type;
+    /**
+     * Destination rectangle of the sprite or the rectangle; for text only @a x and @a y are used as the starting point,
+     * for the terrain it is the rectangle of the whole map on the screen
+     */
+    SDL_Rect dest;
+    /**
+     * Offset from @a dest to the position of the sprite at the previous simulation tick; used for interpolation of moving sprites
+     */
+    SDL_Point motion;
+    /**
+     * Color of the rectangle or the text
+     */
+    SDL_Color color;
+    union
+    {
+        /**
+         * Source rectangle of the sprite in the texture; for the terrain the range of drawn chunks
+         * (x - first chunk column, y - first chunk row, w and h - numbers of chunks)
+         */
+        SDL_Rect src;
+        /**
+         * Font number and position of the text in the text pool of the buffer
+         */
+        struct
+        {
+            int font_size;
+            unsigned offset;
+            unsigned length;
+        } text;
+    };
+};
+
+/**
+ * @brief
+ * Square block of terrain cells. The terrain is kept in chunks, so only chunks that changed are copied between buffers
+ * and redrawn by backends, and only chunks near the visible part of the map are touched at all.
+ */
+struct TerrainChunk
+{
+    /**
+     * Texture rectangles of the cells in row order; an empty cell or a cell outside the map has zero width
+     */
+    std::vector<SDL_Rect> tiles;
+    /**
+     * Number of cells that are not empty
+     */
+    unsigned filled;
+    /**
+     * Number of the state of the chunk, changed with every modification of its cells
+     */
+    unsigned version;
+};
+
+/**
+ * @brief
+ * Class stores drawing commands of one frame. Commands do not refer to any objects of the game, so a filled buffer
+ * can be sorted, executed by any backend, compared or passed to another thread.
+ */
+class RenderCommandBuffer
+{
+public:
+    /**
+     * Number of rows and columns of cells in a terrain chunk
+     */
+    static const int terrain_chunk_size = 16;
+
+    RenderCommandBuffer();
+
+    /**
+     * Removing all commands; the copy of the terrain is kept
+     */
+    void clear();
+    /**
+     * Recording drawing of a texture fragment
+     * @param layer - drawing layer
+     * @param texture_src - source rectangle from texture
+     * @param window_dest - destination rectangle on the screen buffer
+     * @param motion - offset to the position of the sprite at the previous simulation tick
+     */
+    void addSprite(RenderLayer layer, const SDL_Rect& texture_src, const SDL_Rect& window_dest, SDL_Point motion);
+    /**
+     * Recording drawing of a rectangle
+     * @param layer - drawing layer
+     * @param rect - position of the rectangle
+     * @param rect_color - rectangle color
+     * @param fill - variable telling whether the rectangle should be filled
+     */
+    void addRect(RenderLayer layer, const SDL_Rect& rect, SDL_Color rect_color, bool fill);
+    /**
+     * Recording drawing of a text
+     * @param layer - drawing layer
+     * @param start - starting point of the text; negative value of either coordinate results in centering the text on that axis
+     * @param text - drawn text, copied to the text pool
+     * @param text_color - color of the text
+     * @param font_size - font number: 1, 2 or 3
+     */
+    void addText(RenderLayer layer, SDL_Point start, const std::string& text, SDL_Color text_color, int font_size);
+    /**
+     * Recording drawing of the terrain stored in the buffer
+     * @param layer - drawing layer
+     * @param dest - rectangle of the whole map on the screen
+     * @param motion - offset to the position of the map at the previous simulation tick, when the camera moves
+     * @param chunks - range of drawn chunks (x - first chunk column, y - first chunk row, w and h - numbers of chunks); they have to be stored by @a setTerrain
+     */
+    void addTerrain(RenderLayer layer, const SDL_Rect& dest, SDL_Point motion, const SDL_Rect& chunks);
+    /**
+     * Storing a copy of the chunks of the terrain in the given range; a chunk is copied only if its version differs from the version already stored
+     * @param columns - number of map columns
+     * @param rows - number of map rows
+     * @param chunks - all chunks of the terrain in row order
+     * @param range - range of copied chunks (x - first chunk column, y - first chunk row, w and h - numbers of chunks)
+     */
+    void setTerrain(int columns, int rows, const std::vector<TerrainChunk>& chunks, const SDL_Rect& range);
+    /**
+     * Sorting commands by layers, keeping the order of recording inside each layer
+     */
+    void sort();
+    /**
+     * Setting the moment of finishing the frame
+     * @param time - value of @a SDL_GetPerformanceCounter
+     */
+    void setTime(Uint64 time);
+
+    /**
+     * @return recorded commands
+     */
+    const std::vector<RenderCommand>& commands() const;
+    /**
+     * @param command - text command
+     * @return pointer to the first character of the text of the command, the text is not terminated with zero
+     */
+    const char* text(const RenderCommand& command) const;
+    /**
+     * @return number of columns of the stored terrain
+     */
+    int terrainColumns() const;
+    /**
+     * @return number of rows of the stored terrain
+     */
+    int terrainRows() const;
+    /**
+     * @return chunks of the stored terrain in row order; only chunks in the range of the terrain command are up to date
+     */
+    const std::vector<TerrainChunk>& terrainChunks() const;
+    /**
+     * @return moment of finishing the frame as a value of @a SDL_GetPerformanceCounter
+     */
+    Uint64 time() const;
+
+private:
+    /**
+     * Creating a new command with the sorting key
+     * @param layer - drawing layer
+     * @param type - type of the command
+     * @return reference to the added command
+     */
+    RenderCommand& add(RenderLayer layer, RenderCommandType type);
+
+    /**
+     * Recorded commands
+     */
+    std::vector<RenderCommand> m_commands;
+    /**
+     * Characters of all texts of the frame
+     */
+    std::string m_text_pool;
+    /**
+     * Number of columns of the terrain
+     */
+    int m_terrain_columns;
+    /**
+     * Number of rows of the terrain
+     */
+    int m_terrain_rows;
+    /**
+     * Copy of the terrain chunks
+     */
+    std::vector<TerrainChunk> m_terrain_chunks;
+    /**
+     * Moment of finishing the frame
+     */
+    Uint64 m_time;
+};
+
+#endif // RENDERCOMMANDBUFFER_H
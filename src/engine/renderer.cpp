@@ -1,130 +1,293 @@
 #include "renderer.h"
 #include "../appconfig.h"
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
-#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+
+static const int fresh_frame_flag = 4;
+/**
+ * Maximum distance in pixels between two frames that is still treated as motion; longer jumps (e.g. respawning) are not interpolated
+ */
+static const int max_interpolated_distance = 8;
 
 Renderer::Renderer()
 {
-    m_texture = nullptr;
-    m_renderer = nullptr;
-    m_text_texture = nullptr;
-    m_font1 = nullptr;
-    m_font2 = nullptr;
+    m_write_index = 0;
+    m_read_index = 1;
+    SDL_AtomicSet(&m_ready_index, 2);
+    SDL_AtomicSet(&m_draw_calls, 0);
+    SDL_AtomicSet(&m_quads, 0);
+    m_capture_backend = nullptr;
+    m_frame_writer = nullptr;
+    m_has_frame = false;
+    m_presented_alpha = 0;
+    m_frame_event = SDL_RegisterEvents(1);
+    m_frame_number = 1;
+    m_layer = RL_BACKGROUND;
+    m_terrain_columns = 0;
+    m_terrain_rows = 0;
+    m_terrain_version = 0;
+    m_camera = {0, 0};
+    m_previous_camera = {0, 0};
 }
 
 Renderer::~Renderer()
 {
-    if(m_renderer != nullptr)
-        SDL_DestroyRenderer(m_renderer);
-    if(m_texture != nullptr)
-        SDL_DestroyTexture(m_texture);
-    if(m_text_texture != nullptr)
-        SDL_DestroyTexture(m_text_texture);
-    if(m_font1 != nullptr)
-        TTF_CloseFont(m_font1);
-    if(m_font2 != nullptr)
-        TTF_CloseFont(m_font2);
-    if(m_font3 != nullptr)
-        TTF_CloseFont(m_font3);
+    stopCapture();
 }
 
 void Renderer::loadTexture(SDL_Window* window)
 {
-    SDL_Surface* surface = nullptr;
-    m_renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-
-    surface = IMG_Load(AppConfig::texture_path.c_str());
-
-    // load surface
-    if(surface != nullptr && m_renderer != nullptr)
-        m_texture = SDL_CreateTextureFromSurface(m_renderer, surface);
-
-    SDL_FreeSurface(surface);
+    m_backend.loadTexture(window);
 }
 
 void Renderer::loadFont()
 {
-    m_font1 = TTF_OpenFont(AppConfig::font_name.c_str(), 28);
-    m_font2 = TTF_OpenFont(AppConfig::font_name.c_str(), 14);
-    m_font3 = TTF_OpenFont(AppConfig::font_name.c_str(), 10);
+    m_backend.loadFont();
 }
 
 void Renderer::clear()
 {
-    SDL_SetRenderDrawColor(m_renderer, 110, 110, 110, 255);
-    SDL_RenderClear(m_renderer); // we clear the back buffer
+    m_buffers[m_write_index].clear();
+    m_layer = RL_BACKGROUND;
 }
 
 void Renderer::flush()
 {
-    SDL_RenderPresent(m_renderer); // we swap buffers
+    m_buffers[m_write_index].sort();
+    m_buffers[m_write_index].setTime(SDL_GetPerformanceCounter());
+    m_frame_number++;
+    m_previous_camera = m_camera;
+    m_camera = {0, 0};
+
+    if(m_capture_backend != nullptr)
+    {
+        // captured frames show the exact state of the tick, without interpolation
+        m_capture_backend->execute(m_buffers[m_write_index], 1.0f);
+        m_frame_writer->write(m_capture_backend->pixels());
+    }
+
+    SDL_MemoryBarrierRelease(); // the content of the buffer has to be visible before its index
+    int previous = SDL_AtomicSet(&m_ready_index, m_write_index | fresh_frame_flag);
+    m_write_index = previous & ~fresh_frame_flag;
+
+    // wake the main thread only if it took the previous frame, otherwise it is still busy or already notified
+    if(!(previous & fresh_frame_flag) && m_frame_event != static_cast<Uint32>(-1))
+    {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = m_frame_event;
+        SDL_PushEvent(&event);
+    }
 }
 
-void Renderer::drawObject(const SDL_Rect *texture_src, const SDL_Rect *window_dest)
+const RenderCommandBuffer* Renderer::takeFrame()
 {
-    SDL_RenderCopy(m_renderer, m_texture, texture_src, window_dest); // we draw on the back buffer
+    if(!(SDL_AtomicGet(&m_ready_index) & fresh_frame_flag)) return nullptr;
+
+    int previous = SDL_AtomicSet(&m_ready_index, m_read_index);
+    SDL_MemoryBarrierAcquire();
+    m_read_index = previous & ~fresh_frame_flag;
+    m_has_frame = true;
+    return &m_buffers[m_read_index];
 }
 
-void Renderer::setScale(float xs, float ys)
+bool Renderer::present()
+{
+    bool fresh = takeFrame() != nullptr;
+    if(!m_has_frame || (!fresh && m_presented_alpha >= 1.0f)) return false;
+
+    const RenderCommandBuffer& buffer = m_buffers[m_read_index];
+    double tick = SDL_GetPerformanceFrequency() * AppConfig::simulation_tick_time / 1000.0;
+    float alpha = tick > 0 ? (SDL_GetPerformanceCounter() - buffer.time()) / tick : 1.0f;
+    m_presented_alpha = std::min(alpha, 1.0f);
+
+    m_backend.execute(buffer, m_presented_alpha);
+
+    const RenderStats& stats = m_backend.frameStats();
+    SDL_AtomicSet(&m_draw_calls, stats.draw_calls);
+    SDL_AtomicSet(&m_quads, stats.quads);
+    return true;
+}
+
+void Renderer::repaint()
 {
-    float scale = min(xs, ys);
-    if(scale < 0.1) return;
+    m_presented_alpha = 0;
+}
 
-    SDL_Rect viewport;
-    viewport.x = ((float)AppConfig::windows_rect.w / scale - (AppConfig::map_rect.w + AppConfig::status_rect.w)) / 2.0;
-    viewport.y = ((float)AppConfig::windows_rect.h / scale - AppConfig::map_rect.h) / 2.0;
-    if(viewport.x < 0) viewport.x = 0;
-    if(viewport.y < 0) viewport.y = 0;
-    viewport.w = AppConfig::map_rect.w + AppConfig::status_rect.w;
-    viewport.h = AppConfig::map_rect.h;
+Uint32 Renderer::frameEventType() const
+{
+    return m_frame_event;
+}
 
-    SDL_RenderSetScale(m_renderer, scale, scale);
-    SDL_RenderSetViewport(m_renderer, &viewport);
+void Renderer::setLayer(RenderLayer layer)
+{
+    m_layer = layer;
 }
 
-void Renderer::drawText(const SDL_Point* start, string text, SDL_Color text_color, int font_size)
+unsigned Renderer::frameNumber() const
 {
-    if(m_font1 == nullptr || m_font2 == nullptr || m_font3 == nullptr) return;
-    if(m_text_texture != nullptr)
-        SDL_DestroyTexture(m_text_texture);
+    return m_frame_number;
+}
+
+bool Renderer::startCapture(const std::string &directory, FrameFormat format)
+{
+    stopCapture();
 
-    SDL_Surface* text_surface = nullptr;
-    if(font_size == 2) text_surface = TTF_RenderText_Solid(m_font2, text.c_str(), text_color);
-    else if(font_size == 3) text_surface = TTF_RenderText_Solid(m_font3, text.c_str(), text_color);
-    else text_surface = TTF_RenderText_Solid(m_font1, text.c_str(), text_color);
+    m_capture_backend = new SoftwareRenderBackend;
+    m_frame_writer = new FrameWriter;
+    if(!m_capture_backend->load() ||
+       !m_frame_writer->start(directory, format, m_capture_backend->width(), m_capture_backend->height()))
+    {
+        stopCapture();
+        return false;
+    }
+    return true;
+}
 
-    if(text_surface == nullptr) return;
+void Renderer::stopCapture()
+{
+    if(m_frame_writer != nullptr)
+        m_frame_writer->stop();
+    delete m_frame_writer;
+    m_frame_writer = nullptr;
+    delete m_capture_backend;
+    m_capture_backend = nullptr;
+}
 
-    m_text_texture = SDL_CreateTextureFromSurface(m_renderer, text_surface);
-    if(m_text_texture == nullptr) return;
+void Renderer::drawObject(const SDL_Rect *texture_src, const SDL_Rect *window_dest, const SDL_Rect *previous_dest)
+{
+    if(texture_src == nullptr || window_dest == nullptr) return;
 
-    SDL_Rect window_dest;
-    if(start == nullptr)
+    SDL_Rect dest = *window_dest;
+    SDL_Point motion = {0, 0};
+    if(previous_dest != nullptr && previous_dest->w == window_dest->w && previous_dest->h == window_dest->h)
     {
-        window_dest.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - text_surface->w)/2;
-        window_dest.y = (AppConfig::map_rect.h - text_surface->h)/2;
+        motion.x = previous_dest->x - window_dest->x;
+        motion.y = previous_dest->y - window_dest->y;
+        if(isWorldLayer(m_layer))
+        {
+            // on the screen the object moves also with the camera
+            motion.x += m_camera.x - m_previous_camera.x;
+            motion.y += m_camera.y - m_previous_camera.y;
+        }
+        if(abs(motion.x) > max_interpolated_distance || abs(motion.y) > max_interpolated_distance)
+            motion = {0, 0};
     }
-    else
+    if(isWorldLayer(m_layer))
     {
-        if(start->x < 0) window_dest.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - text_surface->w)/2;
-        else window_dest.x = start->x;
-
-        if(start->y < 0) window_dest.y = (AppConfig::map_rect.h - text_surface->h)/2;
-        else window_dest.y = start->y;
+        dest.x += AppConfig::map_rect.x - m_camera.x;
+        dest.y += AppConfig::map_rect.y - m_camera.y;
     }
-    window_dest.w = text_surface->w;
-    window_dest.h = text_surface->h;
+    m_buffers[m_write_index].addSprite(m_layer, *texture_src, dest, motion);
+}
 
-    SDL_RenderCopy(m_renderer, m_text_texture, NULL, &window_dest);
+void Renderer::setScale(float xs, float ys)
+{
+    m_backend.setScale(xs, ys);
+}
+
+void Renderer::drawText(const SDL_Point* start, std::string text, SDL_Color text_color, int font_size)
+{
+    SDL_Point point = {-1, -1};
+    if(start != nullptr) point = *start;
+    m_buffers[m_write_index].addText(m_layer, point, text, text_color, font_size);
 }
 
 void Renderer::drawRect(const SDL_Rect *rect, SDL_Color rect_color, bool fill)
 {
-    SDL_SetRenderDrawColor(m_renderer, rect_color.r, rect_color.g, rect_color.b, rect_color.a);
+    if(rect == nullptr) return;
+
+    SDL_Rect dest = *rect;
+    if(isWorldLayer(m_layer))
+    {
+        dest.x += AppConfig::map_rect.x - m_camera.x;
+        dest.y += AppConfig::map_rect.y - m_camera.y;
+    }
+    m_buffers[m_write_index].addRect(m_layer, dest, rect_color, fill);
+}
+
+void Renderer::setCamera(int x, int y)
+{
+    m_camera = {x, y};
+}
+
+void Renderer::resetTerrain(int columns, int rows)
+{
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunks_count = ((columns + chunk_size - 1) / chunk_size) * ((rows + chunk_size - 1) / chunk_size);
+
+    m_terrain_columns = columns;
+    m_terrain_rows = rows;
+    m_terrain_version++;
+    m_terrain_chunks.assign(chunks_count, TerrainChunk{std::vector<SDL_Rect>(chunk_size * chunk_size, SDL_Rect{0, 0, 0, 0}), 0, m_terrain_version});
+}
+
+void Renderer::setTerrain(int columns, int rows, std::vector<TerrainChunk> &chunks)
+{
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunks_count = ((columns + chunk_size - 1) / chunk_size) * ((rows + chunk_size - 1) / chunk_size);
+    if(static_cast<int>(chunks.size()) != chunks_count)
+    {
+        resetTerrain(columns, rows);
+        return;
+    }
 
-    if(fill)
-        SDL_RenderFillRect(m_renderer, rect);
-    else
-        SDL_RenderDrawRects(m_renderer, rect, 1);
+    m_terrain_columns = columns;
+    m_terrain_rows = rows;
+    m_terrain_version++;
+    m_terrain_chunks.swap(chunks);
+    // the new version differs from the versions of the chunks stored in the buffers, so every chunk is copied once
+    for(TerrainChunk& chunk : m_terrain_chunks) chunk.version = m_terrain_version;
+}
+
+void Renderer::setTerrainTile(int column, int row, const SDL_Rect *texture_src)
+{
+    if(column < 0 || row < 0 || column >= m_terrain_columns || row >= m_terrain_rows) return;
+
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunk_columns = (m_terrain_columns + chunk_size - 1) / chunk_size;
+    TerrainChunk& chunk = m_terrain_chunks[row / chunk_size * chunk_columns + column / chunk_size];
+    SDL_Rect& tile = chunk.tiles[row % chunk_size * chunk_size + column % chunk_size];
+
+    if(tile.w > 0) chunk.filled--;
+    if(texture_src != nullptr) tile = *texture_src;
+    else tile = {0, 0, 0, 0};
+    if(tile.w > 0) chunk.filled++;
+    chunk.version = ++m_terrain_version;
+}
+
+void Renderer::invalidateTerrain()
+{
+    m_backend.invalidateTerrain();
+}
+
+void Renderer::drawTerrain()
+{
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunk_w = chunk_size * AppConfig::tile_rect.w, chunk_h = chunk_size * AppConfig::tile_rect.h;
+    int terrain_w = m_terrain_columns * AppConfig::tile_rect.w, terrain_h = m_terrain_rows * AppConfig::tile_rect.h;
+
+    // chunks which may show up while the motion of the camera is interpolated are included as well
+    int x1 = std::max(m_camera.x - max_interpolated_distance, 0), y1 = std::max(m_camera.y - max_interpolated_distance, 0);
+    int x2 = std::min(m_camera.x + AppConfig::map_rect.w + max_interpolated_distance, terrain_w);
+    int y2 = std::min(m_camera.y + AppConfig::map_rect.h + max_interpolated_distance, terrain_h);
+    SDL_Rect range = {0, 0, 0, 0};
+    if(x1 < x2 && y1 < y2)
+        range = {x1 / chunk_w, y1 / chunk_h, (x2 - 1) / chunk_w - x1 / chunk_w + 1, (y2 - 1) / chunk_h - y1 / chunk_h + 1};
+
+    SDL_Point motion = {m_camera.x - m_previous_camera.x, m_camera.y - m_previous_camera.y};
+    if(abs(motion.x) > max_interpolated_distance || abs(motion.y) > max_interpolated_distance)
+        motion = {0, 0};
+
+    SDL_Rect dest = {AppConfig::map_rect.x - m_camera.x, AppConfig::map_rect.y - m_camera.y, terrain_w, terrain_h};
+    m_buffers[m_write_index].setTerrain(m_terrain_columns, m_terrain_rows, m_terrain_chunks, range);
+    m_buffers[m_write_index].addTerrain(m_layer, dest, motion, range);
+}
+
+RenderStats Renderer::frameStats() const
+{
+    RenderStats stats;
+    stats.draw_calls = SDL_AtomicGet(const_cast<SDL_atomic_t*>(&m_draw_calls));
+    stats.quads = SDL_AtomicGet(const_cast<SDL_atomic_t*>(&m_quads));
+    return stats;
 }
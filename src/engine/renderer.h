@@ -1,13 +1,19 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "framewriter.h"
+#include "rendercommandbuffer.h"
+#include "sdlrenderbackend.h"
+#include "softwarerenderbackend.h"
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
 #include <string>
+#include <vector>
 
 /**
  * @brief
- * Class is responsible for drawing objects on the screen
+ * Class is responsible for drawing objects on the screen. Drawing functions only record commands in the command buffer of the frame.
+ * The simulation thread publishes finished buffers with @a flush and the main thread draws the newest one with @a present.
+ * Three buffers are exchanged without locks: one is written, one is drawn and one holds the newest finished frame.
  */
 class Renderer
 {
@@ -20,23 +26,71 @@ public:
      */
     void loadTexture(SDL_Window* window);
     /**
-     * Loading font in three different sizes
+     * Loading font in three different sizes and rendering all characters of each size into a glyph atlas.
+     * Drawing text later only copies fragments of the atlases, without rasterizing it or creating textures.
      */
     void loadFont();
     /**
-     * Clearing the screen buffer
+     * Starting a new frame: removing commands of the previous frame and setting the background layer;
+     * the screen buffer is cleared when the frame is executed
      */
     void clear();
     /**
-     * Presentation of the screen buffer
+     * Sorting the commands of the frame and publishing them as the newest frame; an older unpresented frame is dropped
      */
     void flush();
+    /**
+     * Taking the newest published frame without drawing it; used when frames are drawn by a backend other than the window one.
+     * The returned buffer stays valid until the next @a takeFrame or @a present call.
+     * @return published frame or @a nullptr if no new frame was published since the last call
+     */
+    const RenderCommandBuffer* takeFrame();
+    /**
+     * Executing the newest published frame and presentation of the screen buffer; called by the main thread.
+     * Moving sprites are drawn between their positions from the previous and the current tick, according to the time
+     * elapsed since the frame was published, so the frame may be presented several times while the simulation waits for the next tick.
+     * @return @a false if nothing was drawn, because there is no new frame and the last one was already presented at its final position
+     */
+    bool present();
+    /**
+     * Forcing the next @a present call to draw the last frame again, even if it was already presented at its final position;
+     * needed when the content of the window was lost, e.g. after the window was resized or exposed. Called by the main thread.
+     */
+    void repaint();
+    /**
+     * @return type of the event pushed to the SDL event queue when @a flush publishes a frame while the main thread has nothing to present,
+     * so that the main thread can block in SDL_WaitEvent; (Uint32)-1 if no event type could be registered
+     */
+    Uint32 frameEventType() const;
+    /**
+     * @return number of the frame being recorded, incremented with each @a flush call
+     */
+    unsigned frameNumber() const;
+    /**
+     * Starting capture of frames: from now on every frame published by @a flush is also drawn by the software backend
+     * and saved by a frame writer. Has to be called after initialization of SDL_image and SDL_ttf.
+     * @param directory - existing directory for the saved files
+     * @param format - file format
+     * @return @a false if the capture could not be started
+     */
+    bool startCapture(const std::string& directory, FrameFormat format);
+    /**
+     * Saving all captured frames and stopping the capture
+     */
+    void stopCapture();
+    /**
+     * Setting the layer of the following drawing commands
+     * @param layer - drawing layer
+     */
+    void setLayer(RenderLayer layer);
     /**
      * Redrawing a texture fragment onto a screen buffer fragment
      * @param texture_src - source rectangle from texture
      * @param window_dest - destination rectangle on the screen buffer
+     * @param previous_dest - destination rectangle of the same object in the previous frame, used for interpolation of its motion;
+     * @a nullptr or a jump further than a few pixels draws the object at @a window_dest
      */
-    void drawObject(const SDL_Rect *texture_src, const SDL_Rect *window_dest);
+    void drawObject(const SDL_Rect *texture_src, const SDL_Rect *window_dest, const SDL_Rect *previous_dest = nullptr);
     /**
      * Setting the scale of the displayed buffer so that it maintains the board's proportions and is positioned in the center of the application window
      * @param xs - horizontal scale as the ratio of window width to map width
@@ -59,32 +113,130 @@ public:
      * @param fill - variable telling whether the rectangle should be filled
      */
     void drawRect(const SDL_Rect* rect, SDL_Color rect_color, bool fill = false);
+    /**
+     * Setting the position of the visible part of the map for the current frame. Commands of the map layers (@a isWorldLayer) are given
+     * in map coordinates; they are moved by the camera and clipped to @a AppConfig::map_rect. The camera is reset to the origin by @a flush.
+     * @param x - horizontal position of the left edge of the visible part of the map in pixels
+     * @param y - vertical position of the top edge of the visible part of the map in pixels
+     */
+    void setCamera(int x, int y);
+    /**
+     * Preparing an empty static map layer (terrain) for a map with the given number of cells. The backend keeps the terrain
+     * in offscreen chunks to which only changed cells are drawn, so drawing the terrain takes a copy per visible chunk.
+     * @param columns - number of map columns
+     * @param rows - number of map rows
+     */
+    void resetTerrain(int columns, int rows);
+    /**
+     * Replacing the whole static map layer (terrain) with chunks prepared in advance, e.g. by @a LevelMap::load on the prefetching thread,
+     * so only the versions of the chunks are set here
+     * @param columns - number of map columns
+     * @param rows - number of map rows
+     * @param chunks - chunks of the terrain in row order; they are taken over and @a chunks is left with the previous terrain.
+     * Chunks of a wrong number give an empty terrain.
+     */
+    void setTerrain(int columns, int rows, std::vector<TerrainChunk>& chunks);
+    /**
+     * Reporting a change of a single map cell
+     * @param column - column of the cell
+     * @param row - row of the cell
+     * @param texture_src - rectangle of the new cell appearance in the texture, @a nullptr for an empty cell
+     */
+    void setTerrainTile(int column, int row, const SDL_Rect* texture_src);
+    /**
+     * Marking all cells as changed; needed after the content of render targets was lost (SDL_RENDER_TARGETS_RESET event)
+     */
+    void invalidateTerrain();
+    /**
+     * Drawing the chunks of the terrain seen by the camera
+     */
+    void drawTerrain();
+    /**
+     * @return statistics of the previously presented frame
+     */
+    RenderStats frameStats() const;
 
 private:
     /**
-     * Pointer to an object associated with the window buffer
+     * Backend drawing the frames in the application window
+     */
+    SdlRenderBackend m_backend;
+    /**
+     * Backend drawing captured frames in memory; @a nullptr if the capture is not running
+     */
+    SoftwareRenderBackend* m_capture_backend;
+    /**
+     * Writer of captured frames; @a nullptr if the capture is not running
+     */
+    FrameWriter* m_frame_writer;
+    /**
+     * Command buffers exchanged between the simulation thread and the main thread
+     */
+    RenderCommandBuffer m_buffers[3];
+    /**
+     * Index of the buffer recorded by the simulation thread
+     */
+    int m_write_index;
+    /**
+     * Index of the buffer drawn by the main thread
+     */
+    int m_read_index;
+    /**
+     * Index of the newest finished buffer, with the @a fresh_frame_flag bit set if it has not been taken by the main thread yet
+     */
+    SDL_atomic_t m_ready_index;
+    /**
+     * Number of draw calls of the previously presented frame
+     */
+    SDL_atomic_t m_draw_calls;
+    /**
+     * Number of quads of the previously presented frame
+     */
+    SDL_atomic_t m_quads;
+    /**
+     * Variable telling whether the buffer @a m_read_index contains a published frame
+     */
+    bool m_has_frame;
+    /**
+     * Interpolation progress with which the buffer @a m_read_index was last presented
+     */
+    float m_presented_alpha;
+    /**
+     * Type of the event announcing a new frame
+     */
+    Uint32 m_frame_event;
+    /**
+     * Number of the frame being recorded
+     */
+    unsigned m_frame_number;
+    /**
+     * Layer of the recorded commands
+     */
+    RenderLayer m_layer;
+    /**
+     * Number of columns of the terrain
      */
-    SDL_Renderer* m_renderer;
+    int m_terrain_columns;
     /**
-     * Pointer to a texture containing all visible game elements
+     * Number of rows of the terrain
      */
-    SDL_Texture* m_texture;
+    int m_terrain_rows;
     /**
-     * Pointer to an auxiliary texture for drawing text on the screen
+     * Terrain chunks in row order
      */
-    SDL_Texture* m_text_texture;
+    std::vector<TerrainChunk> m_terrain_chunks;
     /**
-     * Font with size 28
+     * Number incremented with every change of the terrain; a changed chunk takes the new value as its version
      */
-    TTF_Font* m_font1;
+    unsigned m_terrain_version;
     /**
-     * Font with size 14
+     * Position of the camera in the recorded frame
      */
-    TTF_Font* m_font2;
+    SDL_Point m_camera;
     /**
-     * Font with size 10
+     * Position of the camera in the previous frame
      */
-    TTF_Font* m_font3;
+    SDL_Point m_previous_camera;
 };
 
 #endif // RENDERER_H
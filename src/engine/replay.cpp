@@ -0,0 +1,166 @@
+#include "replay.h"
+#include <cstring>
+
+static const char replay_magic[4] = {'T', 'N', 'K', 'R'};
+static const Uint32 replay_version = 1;
+
+Replay::Replay()
+{
+    m_file = nullptr;
+    m_playing = false;
+    m_seed = 0;
+    m_tick_time = 0;
+    m_keys.assign(SDL_NUM_SCANCODES, 0);
+}
+
+Replay::~Replay()
+{
+    if(m_file != nullptr)
+        fclose(m_file);
+}
+
+bool Replay::record(const std::string &path, Uint32 seed, Uint32 tick_time)
+{
+    if(m_file != nullptr) fclose(m_file);
+    m_file = fopen(path.c_str(), "wb");
+    if(m_file == nullptr) return false;
+
+    m_playing = false;
+    m_seed = seed;
+    m_tick_time = tick_time;
+    m_keys.assign(SDL_NUM_SCANCODES, 0);
+
+    fwrite(replay_magic, 1, sizeof(replay_magic), m_file);
+    writeValue(replay_version, 4);
+    writeValue(m_seed, 4);
+    writeValue(m_tick_time, 4);
+    return true;
+}
+
+void Replay::recordTick(const std::vector<SDL_Event> &events, const Uint8 *keys)
+{
+    if(m_file == nullptr || m_playing) return;
+
+    unsigned count = 0;
+    for(const SDL_Event& event : events)
+        if(event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) count++;
+
+    writeValue(count, 2);
+    for(const SDL_Event& event : events)
+    {
+        if(event.type != SDL_KEYDOWN && event.type != SDL_KEYUP) continue;
+        writeValue(event.type, 4);
+        writeValue(static_cast<Uint32>(event.key.keysym.sym), 4);
+        writeValue(event.key.keysym.scancode, 4);
+        writeValue(event.key.keysym.mod, 2);
+        writeValue(event.key.repeat, 1);
+    }
+
+    count = 0;
+    for(int i = 0; i < SDL_NUM_SCANCODES; i++)
+        if(keys[i] != m_keys[i]) count++;
+
+    writeValue(count, 2);
+    for(int i = 0; i < SDL_NUM_SCANCODES; i++)
+    {
+        if(keys[i] == m_keys[i]) continue;
+        writeValue(i, 2);
+        writeValue(keys[i], 1);
+        m_keys[i] = keys[i];
+    }
+}
+
+bool Replay::play(const std::string &path)
+{
+    if(m_file != nullptr) fclose(m_file);
+    m_file = fopen(path.c_str(), "rb");
+    if(m_file == nullptr) return false;
+
+    char magic[4];
+    Uint32 version;
+    if(fread(magic, 1, sizeof(magic), m_file) != sizeof(magic) || memcmp(magic, replay_magic, sizeof(magic)) != 0 ||
+       !readValue(&version, 4) || version != replay_version || !readValue(&m_seed, 4) || !readValue(&m_tick_time, 4))
+    {
+        fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    m_playing = true;
+    m_keys.assign(SDL_NUM_SCANCODES, 0);
+    return true;
+}
+
+bool Replay::playTick(std::vector<SDL_Event> &events)
+{
+    events.clear();
+    if(m_file == nullptr || !m_playing) return false;
+
+    Uint32 count, value;
+    if(!readValue(&count, 2)) return false;
+    for(unsigned i = 0; i < count; i++)
+    {
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+        if(!readValue(&value, 4)) return false;
+        event.type = value;
+        if(!readValue(&value, 4)) return false;
+        event.key.keysym.sym = static_cast<SDL_Keycode>(value);
+        if(!readValue(&value, 4)) return false;
+        event.key.keysym.scancode = static_cast<SDL_Scancode>(value);
+        if(!readValue(&value, 2)) return false;
+        event.key.keysym.mod = value;
+        if(!readValue(&value, 1)) return false;
+        event.key.repeat = value;
+        event.key.state = event.type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+        events.push_back(event);
+    }
+
+    if(!readValue(&count, 2)) return false;
+    for(unsigned i = 0; i < count; i++)
+    {
+        Uint32 scancode;
+        if(!readValue(&scancode, 2) || !readValue(&value, 1)) return false;
+        if(scancode < SDL_NUM_SCANCODES) m_keys[scancode] = value;
+    }
+    return true;
+}
+
+bool Replay::isPlaying() const
+{
+    return m_file != nullptr && m_playing;
+}
+
+const Uint8 *Replay::keyboardState() const
+{
+    return m_keys.data();
+}
+
+Uint32 Replay::seed() const
+{
+    return m_seed;
+}
+
+Uint32 Replay::tickTime() const
+{
+    return m_tick_time;
+}
+
+void Replay::writeValue(Uint32 value, int size)
+{
+    Uint8 bytes[4];
+    for(int i = 0; i < size; i++)
+        bytes[i] = value >> (8 * i);
+    fwrite(bytes, 1, size, m_file);
+}
+
+bool Replay::readValue(Uint32 *value, int size)
+{
+    Uint8 bytes[4];
+    if(fread(bytes, 1, size, m_file) != static_cast<size_t>(size)) return false;
+
+    *value = 0;
+    for(int i = 0; i < size; i++)
+        *value |= static_cast<Uint32>(bytes[i]) << (8 * i);
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Class records and plays back the input of the simulation tick by tick. Together with the seed of the pseudorandom number generator
+ * and the tick duration it is enough to repeat a game exactly.
+ *
+ * File format (little-endian): header "TNKR", version, seed, tick duration (4 bytes each); then for every tick the number of keyboard events (2 bytes),
+ * the events (type 4, key 4, scancode 4, modifiers 2, repeat 1 bytes), the number of changed keys (2 bytes) and the changes (scancode 2, state 1 bytes).
+ */
+class Replay
+{
+public:
+    Replay();
+    ~Replay();
+
+    /**
+     * Creating a replay file
+     * @param path - path of the file
+     * @param seed - seed passed to @a srand before the first tick
+     * @param tick_time - duration of one tick in milliseconds
+     * @return @a false if the file could not be created
+     */
+    bool record(const std::string& path, Uint32 seed, Uint32 tick_time);
+    /**
+     * Saving the input of one tick
+     * @param events - events passed to the application state in the tick; only keyboard events are saved
+     * @param keys - keyboard state indexed by SDL_Scancode
+     */
+    void recordTick(const std::vector<SDL_Event>& events, const Uint8* keys);
+    /**
+     * Opening a replay file for playback
+     * @param path - path of the file
+     * @return @a false if the file could not be opened or has a wrong header
+     */
+    bool play(const std::string& path);
+    /**
+     * Reading the input of the next tick
+     * @param events - container receiving the events of the tick, previous content is removed
+     * @return @a false at the end of the replay
+     */
+    bool playTick(std::vector<SDL_Event>& events);
+    /**
+     * @return @a true if the replay is being played back, @a false if it is being recorded or not opened
+     */
+    bool isPlaying() const;
+    /**
+     * @return keyboard state after the last played tick
+     */
+    const Uint8* keyboardState() const;
+    /**
+     * @return seed of the pseudorandom number generator
+     */
+    Uint32 seed() const;
+    /**
+     * @return duration of one tick in milliseconds
+     */
+    Uint32 tickTime() const;
+
+private:
+    /**
+     * Writing a number in the little-endian order
+     * @param value - written number
+     * @param size - number of bytes
+     */
+    void writeValue(Uint32 value, int size);
+    /**
+     * Reading a number in the little-endian order
+     * @param value - read number
+     * @param size - number of bytes
+     * @return @a false at the end of the file
+     */
+    bool readValue(Uint32* value, int size);
+
+    /**
+     * Opened file; @a nullptr if the replay is not opened
+     */
+    FILE* m_file;
+    /**
+     * Variable telling whether the file is being played back
+     */
+    bool m_playing;
+    /**
+     * Seed of the pseudorandom number generator
+     */
+    Uint32 m_seed;
+    /**
+     * Duration of one tick in milliseconds
+     */
+    Uint32 m_tick_time;
+    /**
+     * Keyboard state after the last recorded or played tick
+     */
+    std::vector<Uint8> m_keys;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,362 @@
+#include "sdlrenderbackend.h"
+#include "../appconfig.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+
+SdlRenderBackend::SdlRenderBackend()
+{
+    m_texture = nullptr;
+    m_renderer = nullptr;
+    for(auto& texture : m_glyph_textures)
+        texture = nullptr;
+    m_frame_counter = 0;
+    m_batch_texture = nullptr;
+    m_stats = {0, 0};
+    m_last_stats = {0, 0};
+}
+
+SdlRenderBackend::~SdlRenderBackend()
+{
+    // textures have to be destroyed before the renderer that owns them
+    for(auto& cache : m_chunk_caches)
+    {
+        if(cache.second.texture != nullptr)
+            SDL_DestroyTexture(cache.second.texture);
+    }
+    if(m_texture != nullptr)
+        SDL_DestroyTexture(m_texture);
+    for(auto texture : m_glyph_textures)
+    {
+        if(texture != nullptr)
+            SDL_DestroyTexture(texture);
+    }
+    if(m_renderer != nullptr)
+        SDL_DestroyRenderer(m_renderer);
+}
+
+void SdlRenderBackend::loadTexture(SDL_Window* window)
+{
+    SDL_Surface* surface = nullptr;
+    m_renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+    surface = IMG_Load(AppConfig::texture_path.c_str());
+
+    // load surface
+    if(surface != nullptr && m_renderer != nullptr)
+        m_texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+
+    SDL_FreeSurface(surface);
+}
+
+void SdlRenderBackend::loadFont()
+{
+    for(int i = 0; i < GlyphAtlas::fonts_count; i++)
+    {
+        if(!m_glyph_atlas[i].load(i) || m_renderer == nullptr) continue;
+
+        m_glyph_textures[i] = SDL_CreateTextureFromSurface(m_renderer, m_glyph_atlas[i].surface());
+        if(m_glyph_textures[i] != nullptr)
+            SDL_SetTextureBlendMode(m_glyph_textures[i], SDL_BLENDMODE_BLEND);
+    }
+}
+
+void SdlRenderBackend::setScale(float xs, float ys)
+{
+    float scale = min(xs, ys);
+    if(scale < 0.1) return;
+
+    SDL_Rect viewport;
+    viewport.x = ((float)AppConfig::windows_rect.w / scale - (AppConfig::map_rect.w + AppConfig::status_rect.w)) / 2.0;
+    viewport.y = ((float)AppConfig::windows_rect.h / scale - AppConfig::map_rect.h) / 2.0;
+    if(viewport.x < 0) viewport.x = 0;
+    if(viewport.y < 0) viewport.y = 0;
+    viewport.w = AppConfig::map_rect.w + AppConfig::status_rect.w;
+    viewport.h = AppConfig::map_rect.h;
+
+    SDL_RenderSetScale(m_renderer, scale, scale);
+    SDL_RenderSetViewport(m_renderer, &viewport);
+}
+
+void SdlRenderBackend::invalidateTerrain()
+{
+    for(auto& cache : m_chunk_caches)
+        cache.second.valid = false;
+}
+
+void SdlRenderBackend::execute(const RenderCommandBuffer &commands, float alpha)
+{
+    if(m_renderer == nullptr) return;
+
+    float remaining = 1.0f - std::max(0.0f, std::min(alpha, 1.0f));
+    SDL_Rect dest;
+    bool clipped = false;
+    m_frame_counter++;
+
+    SDL_SetRenderDrawColor(m_renderer, 110, 110, 110, 255);
+    SDL_RenderClear(m_renderer); // we clear the back buffer
+
+    for(const RenderCommand& command : commands.commands())
+    {
+        // the map layers are moved by the camera, so they are kept inside the map area
+        if(isWorldLayer(command.layer()) != clipped)
+        {
+            flushBatch();
+            clipped = !clipped;
+            SDL_RenderSetClipRect(m_renderer, clipped ? &AppConfig::map_rect : nullptr);
+        }
+
+        switch(command.type)
+        {
+        case RC_SPRITE:
+            dest = command.dest;
+            if(command.motion.x != 0 || command.motion.y != 0)
+            {
+                dest.x += static_cast<int>(command.motion.x * remaining + (command.motion.x > 0 ? 0.5f : -0.5f));
+                dest.y += static_cast<int>(command.motion.y * remaining + (command.motion.y > 0 ? 0.5f : -0.5f));
+            }
+            batchQuad(m_texture, command.src, dest, command.color); // we draw on the back buffer
+            break;
+        case RC_RECT:
+        case RC_FILL_RECT:
+            drawRect(command);
+            break;
+        case RC_TEXT:
+            drawText(commands, command);
+            break;
+        case RC_TERRAIN:
+            drawTerrain(commands, command, remaining);
+            break;
+        }
+    }
+
+    flushBatch();
+    if(clipped) SDL_RenderSetClipRect(m_renderer, nullptr);
+    evictChunks();
+    SDL_RenderPresent(m_renderer); // we swap buffers
+
+    m_last_stats = m_stats;
+    m_stats = {0, 0};
+}
+
+void SdlRenderBackend::drawText(const RenderCommandBuffer &commands, const RenderCommand &command)
+{
+    int font = GlyphAtlas::fontIndex(command.text.font_size);
+    const GlyphAtlas& atlas = m_glyph_atlas[font];
+    if(m_glyph_textures[font] == nullptr) return;
+
+    const char* text = commands.text(command);
+    SDL_Point pen = atlas.textOrigin({command.dest.x, command.dest.y}, text, command.text.length);
+
+    SDL_Rect window_dest;
+    for(unsigned i = 0; i < command.text.length; i++)
+    {
+        const SDL_Rect* glyph = atlas.glyph(text[i]);
+        if(glyph == nullptr) continue;
+
+        window_dest = {pen.x, pen.y, glyph->w, glyph->h};
+        if(glyph->w > 0) batchQuad(m_glyph_textures[font], *glyph, window_dest, command.color);
+        pen.x += atlas.advance(text[i]);
+    }
+}
+
+void SdlRenderBackend::drawRect(const RenderCommand &command)
+{
+    flushBatch(); // keeps the drawing order of sprites and rectangles
+    m_stats.draw_calls++;
+    m_stats.quads++;
+    SDL_SetRenderDrawColor(m_renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+
+    if(command.type == RC_FILL_RECT)
+        SDL_RenderFillRect(m_renderer, &command.dest);
+    else
+        SDL_RenderDrawRects(m_renderer, &command.dest, 1);
+}
+
+void SdlRenderBackend::drawTerrain(const RenderCommandBuffer &commands, const RenderCommand &command, float remaining)
+{
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunk_w = chunk_size * AppConfig::tile_rect.w, chunk_h = chunk_size * AppConfig::tile_rect.h;
+    int chunk_columns = (commands.terrainColumns() + chunk_size - 1) / chunk_size;
+    const std::vector<TerrainChunk>& chunks = commands.terrainChunks();
+
+    SDL_Point origin = {command.dest.x, command.dest.y};
+    if(command.motion.x != 0 || command.motion.y != 0)
+    {
+        origin.x += static_cast<int>(command.motion.x * remaining + (command.motion.x > 0 ? 0.5f : -0.5f));
+        origin.y += static_cast<int>(command.motion.y * remaining + (command.motion.y > 0 ? 0.5f : -0.5f));
+    }
+
+    for(int y = command.src.y; y < command.src.y + command.src.h; y++)
+        for(int x = command.src.x; x < command.src.x + command.src.w; x++)
+        {
+            int index = y * chunk_columns + x;
+            const TerrainChunk& chunk = chunks[index];
+            SDL_Rect dest = {origin.x + x * chunk_w, origin.y + y * chunk_h,
+                             std::min(chunk_w, command.dest.w - x * chunk_w), std::min(chunk_h, command.dest.h - y * chunk_h)};
+            if(chunk.filled == 0 || !SDL_HasIntersection(&dest, &AppConfig::map_rect)) continue;
+
+            SDL_Texture* texture = updateChunk(index, chunk);
+            if(texture == nullptr)
+            {
+                // without render targets every cell is added to the sprite batch
+                for(int i = 0; i < chunk_size * chunk_size; i++)
+                {
+                    if(chunk.tiles[i].w == 0) continue;
+                    SDL_Rect cell = {dest.x + i % chunk_size * AppConfig::tile_rect.w, dest.y + i / chunk_size * AppConfig::tile_rect.h,
+                                     AppConfig::tile_rect.w, AppConfig::tile_rect.h};
+                    batchQuad(m_texture, chunk.tiles[i], cell, {255, 255, 255, 255});
+                }
+                continue;
+            }
+
+            SDL_Rect src = {0, 0, dest.w, dest.h};
+            batchQuad(texture, src, dest, {255, 255, 255, 255});
+        }
+}
+
+SDL_Texture *SdlRenderBackend::updateChunk(int index, const TerrainChunk &chunk)
+{
+    if(!SDL_RenderTargetSupported(m_renderer)) return nullptr;
+
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    ChunkCache& cache = m_chunk_caches[index];
+    cache.used = m_frame_counter;
+    if(cache.texture == nullptr)
+    {
+        cache.texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                          chunk_size * AppConfig::tile_rect.w, chunk_size * AppConfig::tile_rect.h);
+        if(cache.texture == nullptr)
+        {
+            m_chunk_caches.erase(index);
+            return nullptr;
+        }
+        SDL_SetTextureBlendMode(cache.texture, SDL_BLENDMODE_NONE);
+        cache.valid = false;
+    }
+    if(cache.valid && cache.version == chunk.version) return cache.texture;
+
+    flushBatch();
+    SDL_SetRenderTarget(m_renderer, cache.texture);
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 255);
+
+    // only cells differing from the cache are redrawn, so the cache stays correct even if some versions were never drawn
+    // and when the chunk of another map takes the same index
+    SDL_Rect dest = {0, 0, AppConfig::tile_rect.w, AppConfig::tile_rect.h};
+    std::vector<SDL_Rect> cleared;
+    if(!cache.valid)
+    {
+        SDL_RenderClear(m_renderer);
+        m_stats.draw_calls++;
+    }
+    for(int i = 0; i < chunk_size * chunk_size; i++)
+    {
+        const SDL_Rect& tile = chunk.tiles[i];
+        if(cache.valid && SDL_RectEquals(&tile, &cache.tiles[i])) continue;
+
+        dest.x = i % chunk_size * AppConfig::tile_rect.w;
+        dest.y = i / chunk_size * AppConfig::tile_rect.h;
+        if(cache.valid) cleared.push_back(dest);
+        if(tile.w > 0) batchQuad(m_texture, tile, dest, {255, 255, 255, 255});
+    }
+    if(!cleared.empty())
+    {
+        SDL_RenderFillRects(m_renderer, cleared.data(), cleared.size());
+        m_stats.draw_calls++;
+        m_stats.quads += cleared.size();
+    }
+    flushBatch();
+    SDL_SetRenderTarget(m_renderer, nullptr); // restores the viewport, the clipping and the scale of the window
+
+    cache.tiles = chunk.tiles;
+    cache.version = chunk.version;
+    cache.valid = true;
+    return cache.texture;
+}
+
+void SdlRenderBackend::evictChunks()
+{
+    while(m_chunk_caches.size() > max_cached_chunks)
+    {
+        auto oldest = m_chunk_caches.begin();
+        for(auto it = m_chunk_caches.begin(); it != m_chunk_caches.end(); it++)
+            if(it->second.used < oldest->second.used) oldest = it;
+        if(oldest->second.used == m_frame_counter) break;
+
+        SDL_DestroyTexture(oldest->second.texture);
+        m_chunk_caches.erase(oldest);
+    }
+}
+
+void SdlRenderBackend::batchQuad(SDL_Texture *texture, const SDL_Rect &texture_src, const SDL_Rect &window_dest, SDL_Color color)
+{
+    if(texture == nullptr) return;
+    if(texture != m_batch_texture) flushBatch();
+
+    m_batch_texture = texture;
+    m_batch.push_back({texture_src, window_dest, color});
+}
+
+void SdlRenderBackend::flushBatch()
+{
+    if(m_batch.empty() || m_batch_texture == nullptr)
+    {
+        m_batch.clear();
+        return;
+    }
+    m_stats.quads += m_batch.size();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    int texture_w, texture_h;
+    SDL_QueryTexture(m_batch_texture, NULL, NULL, &texture_w, &texture_h);
+    float u_scale = 1.0f / texture_w, v_scale = 1.0f / texture_h;
+
+    m_batch_vertices.clear();
+    m_batch_indices.clear();
+    for(const BatchQuad& quad : m_batch)
+    {
+        int first = m_batch_vertices.size();
+        float x1 = quad.dest.x, y1 = quad.dest.y;
+        float x2 = quad.dest.x + quad.dest.w, y2 = quad.dest.y + quad.dest.h;
+        float u1 = quad.src.x * u_scale, v1 = quad.src.y * v_scale;
+        float u2 = (quad.src.x + quad.src.w) * u_scale, v2 = (quad.src.y + quad.src.h) * v_scale;
+
+        m_batch_vertices.push_back({{x1, y1}, quad.color, {u1, v1}});
+        m_batch_vertices.push_back({{x2, y1}, quad.color, {u2, v1}});
+        m_batch_vertices.push_back({{x2, y2}, quad.color, {u2, v2}});
+        m_batch_vertices.push_back({{x1, y2}, quad.color, {u1, v2}});
+
+        m_batch_indices.push_back(first);
+        m_batch_indices.push_back(first + 1);
+        m_batch_indices.push_back(first + 2);
+        m_batch_indices.push_back(first);
+        m_batch_indices.push_back(first + 2);
+        m_batch_indices.push_back(first + 3);
+    }
+    SDL_RenderGeometry(m_renderer, m_batch_texture, m_batch_vertices.data(), m_batch_vertices.size(),
+                       m_batch_indices.data(), m_batch_indices.size());
+    m_stats.draw_calls++;
+#else
+    // without geometry rendering every quad is a separate copy; color modulation is changed only between quads of different colors
+    SDL_Color color = {255, 255, 255, 255};
+    for(const BatchQuad& quad : m_batch)
+    {
+        if(quad.color.r != color.r || quad.color.g != color.g || quad.color.b != color.b || quad.color.a != color.a)
+        {
+            color = quad.color;
+            SDL_SetTextureColorMod(m_batch_texture, color.r, color.g, color.b);
+            SDL_SetTextureAlphaMod(m_batch_texture, color.a);
+        }
+        SDL_RenderCopy(m_renderer, m_batch_texture, &quad.src, &quad.dest);
+        m_stats.draw_calls++;
+    }
+    SDL_SetTextureColorMod(m_batch_texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(m_batch_texture, 255);
+#endif
+
+    m_batch.clear();
+}
+
+const RenderStats &SdlRenderBackend::frameStats() const
+{
+    return m_last_stats;
+}
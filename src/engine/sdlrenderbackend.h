@@ -0,0 +1,207 @@
+#ifndef SDLRENDERBACKEND_H
+#define SDLRENDERBACKEND_H
+
+#include "glyphatlas.h"
+#include "renderbackend.h"
+#include <SDL2/SDL.h>
+#include <map>
+#include <vector>
+
+/**
+ * @brief
+ * Structure with the number of operations submitted to the graphics driver during one frame
+ */
+struct RenderStats
+{
+    /**
+     * Number of drawing function calls passed to SDL
+     */
+    unsigned draw_calls;
+    /**
+     * Number of drawn quads (sprites, characters and rectangles)
+     */
+    unsigned quads;
+};
+
+/**
+ * @brief
+ * Class executes drawing commands with the SDL renderer of the application window
+ */
+class SdlRenderBackend : public RenderBackend
+{
+public:
+    SdlRenderBackend();
+    ~SdlRenderBackend();
+    /**
+     * Loading texture from file and creating a renderer associated with the application window
+     * @param window - pointer to the application window content object
+     */
+    void loadTexture(SDL_Window* window);
+    /**
+     * Loading font in three different sizes and rendering all characters of each size into a glyph atlas.
+     * Drawing text later only copies fragments of the atlases, without rasterizing it or creating textures.
+     */
+    void loadFont();
+    /**
+     * Setting the scale of the displayed buffer so that it maintains the board's proportions and is positioned in the center of the application window
+     * @param xs - horizontal scale as the ratio of window width to map width
+     * @param ys - vertical scale as the ratio of window height to map height
+     * @see AppConfig::map_rect
+     */
+    void setScale(float xs, float ys);
+    /**
+     * Marking all terrain chunk caches as lost; needed after the content of render targets was lost (SDL_RENDER_TARGETS_RESET event)
+     */
+    void invalidateTerrain();
+    /**
+     * Clearing the screen buffer, executing the commands and presenting the screen buffer
+     * @param commands - sorted command buffer of the frame
+     * @param alpha - progress between the previous and the current simulation tick, from 0 to 1
+     */
+    void execute(const RenderCommandBuffer& commands, float alpha) override;
+    /**
+     * @return statistics of the previously presented frame
+     */
+    const RenderStats& frameStats() const;
+
+private:
+    /**
+     * Drawing a text command as quads of the glyph atlas
+     * @param commands - command buffer containing the text
+     * @param command - text command
+     */
+    void drawText(const RenderCommandBuffer& commands, const RenderCommand& command);
+    /**
+     * Drawing a rectangle
+     * @param command - rectangle command
+     */
+    void drawRect(const RenderCommand& command);
+    /**
+     * Drawing the terrain chunks of a terrain command from their caches onto the screen buffer
+     * @param commands - command buffer containing the terrain
+     * @param command - terrain command
+     * @param remaining - part of the motion of the command which is still ahead, from 0 to 1
+     */
+    void drawTerrain(const RenderCommandBuffer& commands, const RenderCommand& command, float remaining);
+    /**
+     * Redrawing the cells of a cached chunk that differ from the chunk stored in the command buffer
+     * @param index - index of the chunk
+     * @param chunk - chunk stored in the command buffer
+     * @return texture of the chunk or @a nullptr if render targets are not supported
+     */
+    SDL_Texture* updateChunk(int index, const TerrainChunk& chunk);
+    /**
+     * Destroying the least recently used chunk caches above @a max_cached_chunks
+     */
+    void evictChunks();
+    /**
+     * Adding a textured quad to the sprite batch; the batch is submitted first if it uses a different texture
+     * @param texture - source texture
+     * @param texture_src - source rectangle from texture
+     * @param window_dest - destination rectangle on the current render target
+     * @param color - color multiplied with the texture
+     */
+    void batchQuad(SDL_Texture* texture, const SDL_Rect& texture_src, const SDL_Rect& window_dest, SDL_Color color);
+    /**
+     * Submitting all quads collected in the sprite batch with a single geometry call. The function is called
+     * when the texture of the batch changes, before drawing rectangles, around render target switches and before presentation.
+     */
+    void flushBatch();
+
+    /**
+     * @brief
+     * Offscreen texture with the cells of one terrain chunk
+     */
+    struct ChunkCache
+    {
+        /**
+         * Render target texture of the chunk
+         */
+        SDL_Texture* texture;
+        /**
+         * Cells drawn in the texture
+         */
+        std::vector<SDL_Rect> tiles;
+        /**
+         * Version of the chunk drawn in the texture
+         */
+        unsigned version;
+        /**
+         * Variable telling whether the content of the texture matches @a tiles
+         */
+        bool valid;
+        /**
+         * Number of the frame in which the cache was last used
+         */
+        unsigned used;
+    };
+
+    /**
+     * Maximum number of chunk caches kept between frames; a view of the map needs only a few of them
+     */
+    static const unsigned max_cached_chunks = 64;
+
+    /**
+     * @brief
+     * Single textured quad waiting in the sprite batch
+     */
+    struct BatchQuad
+    {
+        SDL_Rect src;
+        SDL_Rect dest;
+        SDL_Color color;
+    };
+
+    /**
+     * Pointer to an object associated with the window buffer
+     */
+    SDL_Renderer* m_renderer;
+    /**
+     * Pointer to a texture containing all visible game elements
+     */
+    SDL_Texture* m_texture;
+    /**
+     * Glyph atlases of the font with sizes 28, 14 and 10
+     */
+    GlyphAtlas m_glyph_atlas[GlyphAtlas::fonts_count];
+    /**
+     * Textures created from the glyph atlases; the text color is applied with color modulation
+     */
+    SDL_Texture* m_glyph_textures[GlyphAtlas::fonts_count];
+    /**
+     * Caches of terrain chunks by chunk index
+     */
+    std::map<int, ChunkCache> m_chunk_caches;
+    /**
+     * Number of the drawn frame
+     */
+    unsigned m_frame_counter;
+    /**
+     * Texture shared by all quads in @a m_batch
+     */
+    SDL_Texture* m_batch_texture;
+    /**
+     * Quads waiting to be submitted
+     */
+    std::vector<BatchQuad> m_batch;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    /**
+     * Vertex buffer reused by each batch submission
+     */
+    std::vector<SDL_Vertex> m_batch_vertices;
+    /**
+     * Index buffer reused by each batch submission
+     */
+    std::vector<int> m_batch_indices;
+#endif
+    /**
+     * Statistics of the frame being drawn
+     */
+    RenderStats m_stats;
+    /**
+     * Statistics of the previously presented frame
+     */
+    RenderStats m_last_stats;
+};
+
+#endif // SDLRENDERBACKEND_H
@@ -0,0 +1,293 @@
+#include "softwarerenderbackend.h"
+#include "../appconfig.h"
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * Copying visible (non-zero alpha) pixels of one row
+ * @param src - source pixels
+ * @param dst - target pixels
+ * @param count - number of pixels
+ */
+static inline void blitRow(const Uint32* src, Uint32* dst, int count)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), zero);
+        d = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, s));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), d);
+    }
+#endif
+    for(; i < count; i++)
+        if(src[i] & 0xff000000) dst[i] = src[i];
+}
+
+/**
+ * Writing a color in place of visible (non-zero alpha) pixels of one row
+ * @param src - source pixels
+ * @param dst - target pixels
+ * @param count - number of pixels
+ * @param color - written color
+ */
+static inline void blitRowColored(const Uint32* src, Uint32* dst, int count, Uint32 color)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c = _mm_set1_epi32(color);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), zero);
+        d = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, c));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), d);
+    }
+#endif
+    for(; i < count; i++)
+        if(src[i] & 0xff000000) dst[i] = color;
+}
+
+/**
+ * @param color - color
+ * @return opaque color in the ARGB8888 format
+ */
+static inline Uint32 toPixel(SDL_Color color)
+{
+    return 0xff000000 | static_cast<Uint32>(color.r) << 16 | static_cast<Uint32>(color.g) << 8 | color.b;
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend()
+{
+    m_texture = nullptr;
+    m_width = AppConfig::map_rect.w + AppConfig::status_rect.w;
+    m_height = AppConfig::map_rect.h;
+    m_frame.assign(m_width * m_height, 0xff000000);
+    m_clip = {0, 0, m_width, m_height};
+    m_frame_counter = 0;
+}
+
+SoftwareRenderBackend::~SoftwareRenderBackend()
+{
+    if(m_texture != nullptr)
+        SDL_FreeSurface(m_texture);
+}
+
+bool SoftwareRenderBackend::load()
+{
+    SDL_Surface* surface = IMG_Load(AppConfig::texture_path.c_str());
+    if(surface == nullptr) return false;
+
+    m_texture = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surface);
+
+    for(int i = 0; i < GlyphAtlas::fonts_count; i++)
+        m_glyph_atlas[i].load(i);
+
+    return m_texture != nullptr;
+}
+
+void SoftwareRenderBackend::execute(const RenderCommandBuffer &commands, float alpha)
+{
+    float remaining = 1.0f - std::max(0.0f, std::min(alpha, 1.0f));
+    std::fill(m_frame.begin(), m_frame.end(), toPixel({110, 110, 110, 255}));
+    m_frame_counter++;
+
+    // the map layers are moved by the camera, so they are kept inside the map area
+    SDL_Rect screen = {0, 0, m_width, m_height}, map_area;
+    if(!SDL_IntersectRect(&AppConfig::map_rect, &screen, &map_area)) map_area = {0, 0, 0, 0};
+
+    SDL_Rect dest;
+    for(const RenderCommand& command : commands.commands())
+    {
+        m_clip = isWorldLayer(command.layer()) ? map_area : screen;
+        switch(command.type)
+        {
+        case RC_SPRITE:
+            if(m_texture == nullptr) break;
+            dest = command.dest;
+            if(command.motion.x != 0 || command.motion.y != 0)
+            {
+                dest.x += static_cast<int>(command.motion.x * remaining + (command.motion.x > 0 ? 0.5f : -0.5f));
+                dest.y += static_cast<int>(command.motion.y * remaining + (command.motion.y > 0 ? 0.5f : -0.5f));
+            }
+            blit(m_texture, command.src, dest, m_frame.data(), m_width, m_clip, nullptr);
+            break;
+        case RC_RECT:
+            fillRect({command.dest.x, command.dest.y, command.dest.w, 1}, toPixel(command.color));
+            fillRect({command.dest.x, command.dest.y + command.dest.h - 1, command.dest.w, 1}, toPixel(command.color));
+            fillRect({command.dest.x, command.dest.y, 1, command.dest.h}, toPixel(command.color));
+            fillRect({command.dest.x + command.dest.w - 1, command.dest.y, 1, command.dest.h}, toPixel(command.color));
+            break;
+        case RC_FILL_RECT:
+            fillRect(command.dest, toPixel(command.color));
+            break;
+        case RC_TEXT:
+            drawText(commands, command);
+            break;
+        case RC_TERRAIN:
+            drawTerrain(commands, command, remaining);
+            break;
+        }
+    }
+
+    // the least recently used chunk caches are dropped
+    while(m_chunk_caches.size() > max_cached_chunks)
+    {
+        auto oldest = m_chunk_caches.begin();
+        for(auto it = m_chunk_caches.begin(); it != m_chunk_caches.end(); it++)
+            if(it->second.used < oldest->second.used) oldest = it;
+        if(oldest->second.used == m_frame_counter) break;
+        m_chunk_caches.erase(oldest);
+    }
+}
+
+const Uint32 *SoftwareRenderBackend::pixels() const
+{
+    return m_frame.data();
+}
+
+int SoftwareRenderBackend::width() const
+{
+    return m_width;
+}
+
+int SoftwareRenderBackend::height() const
+{
+    return m_height;
+}
+
+void SoftwareRenderBackend::blit(const SDL_Surface *source, const SDL_Rect &src, const SDL_Rect &dest, Uint32 *target, int target_w, const SDL_Rect &clip, const Uint32 *color)
+{
+    if(src.w <= 0 || src.h <= 0 || dest.w <= 0 || dest.h <= 0) return;
+
+    int x1 = std::max(dest.x, clip.x), y1 = std::max(dest.y, clip.y);
+    int x2 = std::min(dest.x + dest.w, clip.x + clip.w), y2 = std::min(dest.y + dest.h, clip.y + clip.h);
+    if(x1 >= x2 || y1 >= y2) return;
+
+    const Uint8* source_pixels = static_cast<const Uint8*>(source->pixels);
+    if(src.w == dest.w && src.h == dest.h)
+    {
+        for(int y = y1; y < y2; y++)
+        {
+            const Uint32* src_row = reinterpret_cast<const Uint32*>(source_pixels + (src.y + y - dest.y) * source->pitch) + src.x + x1 - dest.x;
+            Uint32* dst_row = target + y * target_w + x1;
+            if(color == nullptr) blitRow(src_row, dst_row, x2 - x1);
+            else blitRowColored(src_row, dst_row, x2 - x1, *color);
+        }
+        return;
+    }
+
+    // sprites drawn in a different size (e.g. icons in the status area) are scaled with the nearest pixel
+    for(int y = y1; y < y2; y++)
+    {
+        const Uint32* src_row = reinterpret_cast<const Uint32*>(source_pixels + (src.y + (y - dest.y) * src.h / dest.h) * source->pitch);
+        Uint32* dst_row = target + y * target_w;
+        for(int x = x1; x < x2; x++)
+        {
+            Uint32 pixel = src_row[src.x + (x - dest.x) * src.w / dest.w];
+            if(pixel & 0xff000000) dst_row[x] = color == nullptr ? pixel : *color;
+        }
+    }
+}
+
+void SoftwareRenderBackend::fillRect(const SDL_Rect &rect, Uint32 color)
+{
+    int x1 = std::max(rect.x, m_clip.x), y1 = std::max(rect.y, m_clip.y);
+    int x2 = std::min(rect.x + rect.w, m_clip.x + m_clip.w), y2 = std::min(rect.y + rect.h, m_clip.y + m_clip.h);
+    for(int y = y1; y < y2; y++)
+        std::fill(m_frame.begin() + y * m_width + x1, m_frame.begin() + y * m_width + x2, color);
+}
+
+void SoftwareRenderBackend::drawText(const RenderCommandBuffer &commands, const RenderCommand &command)
+{
+    const GlyphAtlas& atlas = m_glyph_atlas[GlyphAtlas::fontIndex(command.text.font_size)];
+    if(atlas.surface() == nullptr) return;
+
+    const char* text = commands.text(command);
+    SDL_Point pen = atlas.textOrigin({command.dest.x, command.dest.y}, text, command.text.length);
+    Uint32 color = toPixel(command.color);
+
+    for(unsigned i = 0; i < command.text.length; i++)
+    {
+        const SDL_Rect* glyph = atlas.glyph(text[i]);
+        if(glyph == nullptr) continue;
+
+        blit(atlas.surface(), *glyph, {pen.x, pen.y, glyph->w, glyph->h}, m_frame.data(), m_width, m_clip, &color);
+        pen.x += atlas.advance(text[i]);
+    }
+}
+
+void SoftwareRenderBackend::drawTerrain(const RenderCommandBuffer &commands, const RenderCommand &command, float remaining)
+{
+    if(m_texture == nullptr) return;
+
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunk_w = chunk_size * AppConfig::tile_rect.w, chunk_h = chunk_size * AppConfig::tile_rect.h;
+    int chunk_columns = (commands.terrainColumns() + chunk_size - 1) / chunk_size;
+    const std::vector<TerrainChunk>& chunks = commands.terrainChunks();
+
+    SDL_Point origin = {command.dest.x, command.dest.y};
+    if(command.motion.x != 0 || command.motion.y != 0)
+    {
+        origin.x += static_cast<int>(command.motion.x * remaining + (command.motion.x > 0 ? 0.5f : -0.5f));
+        origin.y += static_cast<int>(command.motion.y * remaining + (command.motion.y > 0 ? 0.5f : -0.5f));
+    }
+
+    for(int y = command.src.y; y < command.src.y + command.src.h; y++)
+        for(int x = command.src.x; x < command.src.x + command.src.w; x++)
+        {
+            int index = y * chunk_columns + x;
+            const TerrainChunk& chunk = chunks[index];
+            SDL_Rect dest = {origin.x + x * chunk_w, origin.y + y * chunk_h,
+                             std::min(chunk_w, command.dest.w - x * chunk_w), std::min(chunk_h, command.dest.h - y * chunk_h)};
+            SDL_Rect visible;
+            if(chunk.filled == 0 || !SDL_IntersectRect(&dest, &m_clip, &visible)) continue;
+
+            const std::vector<Uint32>& pixels = updateChunk(index, chunk);
+            for(int row = visible.y; row < visible.y + visible.h; row++)
+                memcpy(&m_frame[row * m_width + visible.x], &pixels[(row - dest.y) * chunk_w + visible.x - dest.x], visible.w * sizeof(Uint32));
+        }
+}
+
+const std::vector<Uint32> &SoftwareRenderBackend::updateChunk(int index, const TerrainChunk &chunk)
+{
+    const int chunk_size = RenderCommandBuffer::terrain_chunk_size;
+    int chunk_w = chunk_size * AppConfig::tile_rect.w, chunk_h = chunk_size * AppConfig::tile_rect.h;
+    ChunkCache& cache = m_chunk_caches[index];
+    cache.used = m_frame_counter;
+
+    // a cache without cells has not been drawn yet
+    bool valid = !cache.tiles.empty();
+    if(!valid) cache.pixels.assign(chunk_w * chunk_h, 0xff000000);
+    if(valid && cache.version == chunk.version) return cache.pixels;
+
+    // only cells differing from the cached chunk are redrawn
+    SDL_Rect dest = {0, 0, AppConfig::tile_rect.w, AppConfig::tile_rect.h};
+    SDL_Rect bounds = {0, 0, chunk_w, chunk_h};
+    for(int i = 0; i < chunk_size * chunk_size; i++)
+    {
+        if(valid && SDL_RectEquals(&chunk.tiles[i], &cache.tiles[i])) continue;
+
+        dest.x = i % chunk_size * AppConfig::tile_rect.w;
+        dest.y = i / chunk_size * AppConfig::tile_rect.h;
+        for(int y = dest.y; y < dest.y + dest.h; y++)
+            std::fill(cache.pixels.begin() + y * chunk_w + dest.x, cache.pixels.begin() + y * chunk_w + dest.x + dest.w, 0xff000000);
+        if(chunk.tiles[i].w > 0)
+            blit(m_texture, chunk.tiles[i], dest, cache.pixels.data(), chunk_w, bounds, nullptr);
+    }
+    cache.tiles = chunk.tiles;
+    cache.version = chunk.version;
+    return cache.pixels;
+}
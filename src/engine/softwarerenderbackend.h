@@ -0,0 +1,147 @@
+#ifndef SOFTWARERENDERBACKEND_H
+#define SOFTWARERENDERBACKEND_H
+
+#include "glyphatlas.h"
+#include "renderbackend.h"
+#include <SDL2/SDL.h>
+#include <map>
+#include <vector>
+
+/**
+ * @brief
+ * Class executes drawing commands on the CPU into a framebuffer in memory, without a window or a graphics driver.
+ * Pixels are stored in the ARGB8888 format; sprite pixels are copied where their alpha is not zero, like the pixel art of the texture expects.
+ */
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+    SoftwareRenderBackend();
+    ~SoftwareRenderBackend();
+
+    /**
+     * Loading the texture @a AppConfig::texture_path and the glyph atlases; the SDL_image and SDL_ttf libraries have to be initialized
+     * @return @a true if the texture was loaded
+     */
+    bool load();
+    /**
+     * Drawing the frame into the framebuffer
+     * @param commands - sorted command buffer of the frame
+     * @param alpha - progress between the previous and the current simulation tick, from 0 to 1
+     */
+    void execute(const RenderCommandBuffer& commands, float alpha) override;
+    /**
+     * @return pixels of the last drawn frame, row after row without padding
+     */
+    const Uint32* pixels() const;
+    /**
+     * @return width of the framebuffer: width of the board and of the status area
+     */
+    int width() const;
+    /**
+     * @return height of the framebuffer: height of the board
+     */
+    int height() const;
+
+private:
+    /**
+     * Copying a fragment of a surface into a pixel buffer, skipping transparent pixels; fragments of different sizes are scaled with the nearest pixel
+     * @param source - source surface in the ARGB8888 format
+     * @param src - source rectangle
+     * @param dest - destination rectangle
+     * @param target - target pixels
+     * @param target_w - width of the target
+     * @param clip - part of the target that may be changed; has to lie inside the target
+     * @param color - @a nullptr to copy the source pixels, otherwise the color written in place of every visible source pixel (used for text)
+     */
+    static void blit(const SDL_Surface* source, const SDL_Rect& src, const SDL_Rect& dest, Uint32* target, int target_w, const SDL_Rect& clip, const Uint32* color);
+    /**
+     * Filling a rectangle of the clipped part of the framebuffer with a color, without blending
+     * @param rect - filled rectangle
+     * @param color - color in the ARGB8888 format
+     */
+    void fillRect(const SDL_Rect& rect, Uint32 color);
+    /**
+     * Drawing a text command
+     * @param commands - command buffer containing the text
+     * @param command - text command
+     */
+    void drawText(const RenderCommandBuffer& commands, const RenderCommand& command);
+    /**
+     * Copying the terrain chunks of a terrain command into the framebuffer
+     * @param commands - command buffer containing the terrain
+     * @param command - terrain command
+     * @param remaining - part of the motion of the command which is still ahead, from 0 to 1
+     */
+    void drawTerrain(const RenderCommandBuffer& commands, const RenderCommand& command, float remaining);
+    /**
+     * Redrawing the cells of a cached chunk that differ from the chunk stored in the command buffer
+     * @param index - index of the chunk
+     * @param chunk - chunk stored in the command buffer
+     * @return pixels of the chunk
+     */
+    const std::vector<Uint32>& updateChunk(int index, const TerrainChunk& chunk);
+
+    /**
+     * @brief
+     * Pixels of one terrain chunk
+     */
+    struct ChunkCache
+    {
+        /**
+         * Pixels of the chunk
+         */
+        std::vector<Uint32> pixels;
+        /**
+         * Cells drawn in the pixels
+         */
+        std::vector<SDL_Rect> tiles;
+        /**
+         * Version of the chunk drawn in the pixels
+         */
+        unsigned version;
+        /**
+         * Number of the frame in which the cache was last used
+         */
+        unsigned used;
+    };
+
+    /**
+     * Maximum number of chunk caches kept between frames
+     */
+    static const unsigned max_cached_chunks = 64;
+
+    /**
+     * Texture with all game elements converted to ARGB8888
+     */
+    SDL_Surface* m_texture;
+    /**
+     * Glyph atlases of the font with sizes 28, 14 and 10
+     */
+    GlyphAtlas m_glyph_atlas[GlyphAtlas::fonts_count];
+    /**
+     * Width of the framebuffer
+     */
+    int m_width;
+    /**
+     * Height of the framebuffer
+     */
+    int m_height;
+    /**
+     * Pixels of the framebuffer
+     */
+    std::vector<Uint32> m_frame;
+    /**
+     * Part of the framebuffer changed by the executed command: the map area for the map layers, the whole framebuffer otherwise
+     */
+    SDL_Rect m_clip;
+    /**
+     * Caches of terrain chunks by chunk index
+     */
+    std::map<int, ChunkCache> m_chunk_caches;
+    /**
+     * Number of the drawn frame
+     */
+    unsigned m_frame_counter;
+};
+
+#endif // SOFTWARERENDERBACKEND_H
@@ -1,55 +1,189 @@
 #include "spriteconfig.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * Animations in the order of @a SpriteType. Tanks of enemies have 4 directions for each of 4 armour levels,
+ * preceded by 4 directions of a tank carrying a bonus; players have 4 directions with 2 frames for each of 4 star levels.
+ */
+static constexpr SpriteData sprite_table[] =
+{
+    SpriteData(ST_TANK_A, "tank_a", 128, 0, 32, 32, 2, 100, true, -4, 20),
+    SpriteData(ST_TANK_B, "tank_b", 128, 64, 32, 32, 2, 100, true, -4, 20),
+    SpriteData(ST_TANK_C, "tank_c", 128, 128, 32, 32, 2, 100, true, -4, 20),
+    SpriteData(ST_TANK_D, "tank_d", 128, 192, 32, 32, 2, 100, true, -4, 20),
+
+    SpriteData(ST_PLAYER_1, "player_1", 640, 0, 32, 32, 2, 50, true, 0, 4, 8),
+    SpriteData(ST_PLAYER_2, "player_2", 768, 0, 32, 32, 2, 50, true, 0, 4, 8),
+
+    SpriteData(ST_BRICK_WALL, "brick_wall", 928, 0, 16, 16, 1, 200, false, 0, 1, 10),
+    SpriteData(ST_STONE_WALL, "stone_wall", 928, 144, 16, 16, 1, 200, false),
+    SpriteData(ST_WATER, "water", 928, 160, 16, 16, 2, 350, true),
+    SpriteData(ST_BUSH, "bush", 928, 192, 16, 16, 1, 200, false),
+    SpriteData(ST_ICE, "ice", 928, 208, 16, 16, 1, 200, false),
+
+    SpriteData(ST_BONUS_GRENADE, "bonus_grenade", 896, 0, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_HELMET, "bonus_helmet", 896, 32, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_CLOCK, "bonus_clock", 896, 64, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_SHOVEL, "bonus_shovel", 896, 96, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_TANK, "bonus_tank", 896, 128, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_STAR, "bonus_star", 896, 160, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_GUN, "bonus_gun", 896, 192, 32, 32, 1, 200, false),
+    SpriteData(ST_BONUS_BOAT, "bonus_boat", 896, 224, 32, 32, 1, 200, false),
+
+    SpriteData(ST_SHIELD, "shield", 976, 0, 32, 32, 2, 45, true),
+    SpriteData(ST_CREATE, "create", 1008, 0, 32, 32, 10, 100, false),
+    SpriteData(ST_DESTROY_TANK, "destroy_tank", 1040, 0, 64, 64, 7, 70, false, 0, 1, 8),
+    SpriteData(ST_DESTROY_BULLET, "destroy_bullet", 1108, 0, 32, 32, 5, 40, false),
+    SpriteData(ST_BOAT_P1, "boat_p1", 944, 96, 32, 32, 1, 200, false),
+    SpriteData(ST_BOAT_P2, "boat_p2", 976, 96, 32, 32, 1, 200, false),
+
+    SpriteData(ST_EAGLE, "eagle", 944, 0, 32, 32, 1, 200, false),
+    SpriteData(ST_DESTROY_EAGLE, "destroy_eagle", 1040, 0, 64, 64, 7, 100, false),
+    SpriteData(ST_FLAG, "flag", 944, 32, 32, 32, 1, 200, false),
+
+    SpriteData(ST_BULLET, "bullet", 944, 128, 8, 8, 1, 200, false, 0, 4),
+
+    SpriteData(ST_LEFT_ENEMY, "left_enemy", 944, 144, 16, 16, 1, 200, false),
+    SpriteData(ST_STAGE_STATUS, "stage_status", 976, 64, 32, 32, 1, 200, false),
+
+    SpriteData(ST_TANKS_LOGO, "tanks_logo", 0, 260, 406, 72, 1, 200, false),
+};
+
+/**
+ * Checking at compile time that entry @a i and all following entries of @a sprite_table are in the order of @a SpriteType
+ */
+static constexpr bool spriteTableOrdered(int i)
+{
+    return i == ST_NONE || (sprite_table[i].type == i && spriteTableOrdered(i + 1));
+}
+
+static_assert(sizeof(sprite_table) / sizeof(sprite_table[0]) == ST_NONE, "sprite_table must contain every SpriteType");
+static_assert(spriteTableOrdered(0), "sprite_table must be in the order of SpriteType");
 
 SpriteConfig::SpriteConfig()
 {
-    insert(ST_TANK_A, 128, 0, 32, 32, 2, 100, true);
-    insert(ST_TANK_B, 128, 64, 32, 32, 2, 100, true);
-    insert(ST_TANK_C, 128, 128, 32, 32, 2, 100, true);
-    insert(ST_TANK_D, 128, 192, 32, 32, 2, 100, true);
-
-    insert(ST_PLAYER_1, 640, 0, 32, 32, 2, 50, true);
-    insert(ST_PLAYER_2, 768, 0, 32, 32, 2, 50, true);
-
-    insert(ST_BRICK_WALL, 928, 0, 16, 16, 1, 200, false);
-    insert(ST_STONE_WALL, 928, 144, 16, 16, 1, 200, false);
-    insert(ST_WATER, 928, 160, 16, 16, 2, 350, true);
-    insert(ST_BUSH, 928, 192, 16, 16, 1, 200, false);
-    insert(ST_ICE, 928, 208, 16, 16, 1, 200, false);
-
-    insert(ST_BONUS_GRENADE, 896, 0, 32, 32, 1, 200, false);
-    insert(ST_BONUS_HELMET, 896, 32, 32, 32, 1, 200, false);
-    insert(ST_BONUS_CLOCK, 896, 64, 32, 32, 1, 200, false);
-    insert(ST_BONUS_SHOVEL, 896, 96, 32, 32, 1, 200, false);
-    insert(ST_BONUS_TANK, 896, 128, 32, 32, 1, 200, false);
-    insert(ST_BONUS_STAR, 896, 160, 32, 32, 1, 200, false);
-    insert(ST_BONUS_GUN, 896, 192, 32, 32, 1, 200, false);
-    insert(ST_BONUS_BOAT, 896, 224, 32, 32, 1, 200, false);
-
-    insert(ST_SHIELD, 976, 0, 32, 32, 2, 45, true);
-    insert(ST_CREATE, 1008, 0, 32, 32, 10, 100, false);
-    insert(ST_DESTROY_TANK, 1040, 0, 64, 64, 7, 70, false);
-    insert(ST_DESTROY_BULLET, 1108, 0, 32, 32, 5, 40, false);
-    insert(ST_BOAT_P1, 944, 96, 32, 32, 1, 200, false);
-    insert(ST_BOAT_P2, 976, 96, 32, 32, 1, 200, false);
-
-    insert(ST_EAGLE, 944, 0, 32, 32, 1, 200, false);
-    insert(ST_DESTROY_EAGLE, 1040, 0, 64, 64, 7, 100, false);
-    insert(ST_FLAG, 944, 32, 32, 32, 1, 200, false);
-
-    insert(ST_BULLET, 944, 128, 8, 8, 1, 200, false);
-
-    insert(ST_LEFT_ENEMY, 944, 144, 16, 16, 1, 200, false);
-    insert(ST_STAGE_STATUS, 976, 64, 32, 32, 1, 200, false);
-
-    insert(ST_TANKS_LOGO, 0, 260, 406, 72, 1, 200, false);
+    for(int st = 0; st < ST_NONE; st++)
+    {
+        SpriteData& data = m_configs[st];
+        data = sprite_table[st];
+        data.first_frame = m_frames.size();
+        for(int c = 0; c < data.columns; c++)
+            for(int r = 0; r < data.rows; r++)
+            {
+                SDL_Rect rect = {data.rect.x + (data.first_column + c) * data.rect.w, data.rect.y + r * data.rect.h, data.rect.w, data.rect.h};
+                m_frames.push_back(rect);
+            }
+    }
 }
 
-const SpriteData* SpriteConfig::getSpriteData(SpriteType st) const
+/**
+ * Reading a little-endian number from a manifest
+ * @param file - opened file
+ * @param size - number of bytes
+ * @param value - read number
+ * @return @a false at the end of the file
+ */
+static bool readValue(FILE* file, int size, Uint32* value)
 {
-    return &m_configs.at(st);
+    Uint8 bytes[4];
+    if(fread(bytes, 1, size, file) != static_cast<size_t>(size)) return false;
+
+    *value = 0;
+    for(int i = 0; i < size; i++)
+        *value |= static_cast<Uint32>(bytes[i]) << (8 * i);
+    return true;
+}
+
+/**
+ * Reading a string preceded by its length from a manifest
+ * @param file - opened file
+ * @param size - number of bytes of the length
+ * @param text - read string
+ * @return @a false at the end of the file
+ */
+static bool readString(FILE* file, int size, std::string* text)
+{
+    Uint32 length;
+    if(!readValue(file, size, &length)) return false;
+    text->resize(length);
+    return length == 0 || fread(&(*text)[0], 1, length, file) == length;
+}
+
+bool SpriteConfig::load(const std::string &path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if(file == nullptr) return false;
+
+    SpriteData configs[ST_NONE];
+    bool found[ST_NONE] = {};
+    std::vector<SDL_Rect> frames;
+    std::string texture_name, name;
+    char magic[4];
+    Uint32 version, atlas_w, atlas_h, count, value = 0;
+    bool valid = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, "TNKA", sizeof(magic)) == 0 &&
+                 readValue(file, 4, &version) && version == 1 && readValue(file, 4, &atlas_w) && readValue(file, 4, &atlas_h) &&
+                 readString(file, 2, &texture_name) && readValue(file, 4, &count);
+
+    for(Uint32 i = 0; valid && i < count; i++)
+    {
+        SpriteData data;
+        Uint32 frames_count, duration, loop, first_column, columns, rows;
+        valid = readString(file, 1, &name) && readValue(file, 4, &frames_count) && readValue(file, 4, &duration) && readValue(file, 1, &loop) &&
+                readValue(file, 4, &first_column) && readValue(file, 4, &columns) && readValue(file, 4, &rows) &&
+                columns > 0 && columns < 256 && rows >= frames_count && rows < 256;
+        if(!valid) break;
+
+        int st = 0;
+        while(st < ST_NONE && name != sprite_table[st].name) st++;
+
+        data = st < ST_NONE ? sprite_table[st] : SpriteData();
+        data.frames_count = frames_count;
+        data.frame_duration = duration;
+        data.loop = loop != 0;
+        data.first_column = static_cast<Sint32>(first_column);
+        data.columns = columns;
+        data.rows = rows;
+        data.first_frame = frames.size();
+        for(Uint32 f = 0; valid && f < columns * rows; f++)
+        {
+            SDL_Rect rect;
+            valid = readValue(file, 2, &value);
+            rect.x = value;
+            valid = valid && readValue(file, 2, &value);
+            rect.y = value;
+            valid = valid && readValue(file, 2, &value);
+            rect.w = value;
+            valid = valid && readValue(file, 2, &value);
+            rect.h = value;
+            valid = valid && static_cast<Uint32>(rect.x + rect.w) <= atlas_w && static_cast<Uint32>(rect.y + rect.h) <= atlas_h;
+            frames.push_back(rect);
+        }
+        if(!valid || st == ST_NONE) continue; // animations unknown to this version are skipped
+
+        // frame 0 of the variant 0 also gives the size of the animation
+        unsigned variant_zero = -data.first_column;
+        data.rect = frames[data.first_frame + (variant_zero < columns ? variant_zero * rows : 0)];
+        configs[st] = data;
+        found[st] = true;
+    }
+    fclose(file);
+
+    for(int st = 0; valid && st < ST_NONE; st++)
+        valid = found[st];
+    if(!valid) return false;
+
+    for(int st = 0; st < ST_NONE; st++)
+        m_configs[st] = configs[st];
+    m_frames.swap(frames);
+
+    // the image is stored next to the manifest
+    size_t separator = path.find_last_of("/\\");
+    m_texture_path = (separator == std::string::npos ? std::string() : path.substr(0, separator + 1)) + texture_name;
+    return true;
 }
 
-void SpriteConfig::insert(SpriteType st, int x, int y, int w, int h, int fc, int fd, bool l)
+const std::string &SpriteConfig::texturePath() const
 {
-    m_configs[st] = SpriteData(x, y, w, h, fc, fd, l);
+    return m_texture_path;
 }
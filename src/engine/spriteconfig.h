@@ -2,8 +2,9 @@
 #define SPRITECONFIG_H
 
 #include "../type.h"
-#include <map>
 #include <SDL2/SDL.h>
+#include <string>
+#include <vector>
 
 /**
  * @brief
@@ -11,12 +12,22 @@
  */
 struct SpriteData
 {
-    SpriteData() { rect.x = 0; rect.y = 0; rect.w = 0; rect.h = 0; frames_count = 0; frame_duration = 0; loop = false;}
-    SpriteData(int x, int y, int w, int h, int fc, int fd, bool l)
-        { rect.x = x; rect.y = y; rect.w = w; rect.h = h; frames_count = fc; frame_duration = fd; loop = l;}
+    constexpr SpriteData() : type(ST_NONE), name(""), rect{0, 0, 0, 0}, frames_count(0), frame_duration(0), loop(false),
+        first_column(0), columns(0), rows(0), first_frame(0) {}
+    constexpr SpriteData(SpriteType st, const char* n, int x, int y, int w, int h, int fc, unsigned fd, bool l, int fcol = 0, int cols = 1, int r = 0)
+        : type(st), name(n), rect{x, y, w, h}, frames_count(fc), frame_duration(fd), loop(l),
+          first_column(fcol), columns(cols), rows(r > 0 ? r : fc), first_frame(0) {}
 
     /**
-     * Position and dimensions of the first animation frame
+     * Animation type described by the structure
+     */
+    SpriteType type;
+    /**
+     * Name of the animation in the atlas manifest
+     */
+    const char* name;
+    /**
+     * Position and dimensions of the first frame of the variant 0
      */
     SDL_Rect rect;
     /**
@@ -31,42 +42,88 @@ struct SpriteData
      * Variable determining whether the animation is looped
      */
     bool loop;
+    /**
+     * Column of the first variant of the sprite (e.g. direction), relative to @a rect; in the built-in texture variants are placed next to each other
+     */
+    int first_column;
+    /**
+     * Number of variants of the sprite
+     */
+    int columns;
+    /**
+     * Number of frames of each variant, in the built-in texture placed one below another; it includes the position after the last frame
+     * of animations that stay there when finished
+     */
+    int rows;
+    /**
+     * Index of the frame rectangle of the first variant in the table of @a SpriteConfig
+     */
+    unsigned first_frame;
 };
 
 /**
  * @brief
- * Class stores information about all types of animations in the game
+ * Class stores information about all types of animations in the game. The animations are taken from a table built at compile time
+ * and indexed by @a SpriteType; source rectangles of all frames of all variants are computed once in the constructor.
+ * The table can be replaced by an atlas manifest written by the @a atlaspacker tool, which stores the rectangle of every frame explicitly.
+ *
+ * Manifest format (little-endian): header "TNKA", version, atlas width, atlas height (4 bytes each), length of the name of the atlas image (2 bytes)
+ * and the name, number of animations (4 bytes); then for every animation the length of its name (1 byte) and the name, number of frames,
+ * frame duration (4 bytes each), loop (1 byte), first column, number of columns, number of rows (4 bytes each) and the frame rectangles
+ * of all columns one after another (x, y, w, h; 2 bytes each).
  */
 class SpriteConfig
 {
 public:
     /**
-     * In the constructor, successive animations are added using the @a SpriteConfig::insert function
+     * In the constructor, the animation table is copied and frame rectangles of every animation are computed
      */
     SpriteConfig();
+    /**
+     * Replacing all animations with the ones from an atlas manifest; the current animations are kept if the manifest cannot be read
+     * or does not describe every animation type
+     * @param path - path of the manifest
+     * @return @a false if the manifest was not loaded
+     */
+    bool load(const std::string& path);
+    /**
+     * @return path of the texture the animations refer to; empty for the built-in table
+     */
+    const std::string& texturePath() const;
     /**
      * Getting the selected animation type
      * @param sp - searched animation type
      * @return animation of a given type
      */
-    const SpriteData* getSpriteData(SpriteType sp) const;
+    const SpriteData* getSpriteData(SpriteType sp) const { return &m_configs[sp]; }
+    /**
+     * Getting the frame table of a variant of an animation
+     * @param sprite - animation
+     * @param column - variant of the sprite (e.g. direction), 0 is the variant at @a SpriteData::rect
+     * @param first_row - row of the first frame of the variant, e.g. for sprites with frames of several star levels placed one below another
+     * @return source rectangles of consecutive frames, indexed by the number of the frame; @a nullptr if the variant is outside the layout of the animation
+     */
+    const SDL_Rect* variantFrames(const SpriteData* sprite, int column, int first_row = 0) const;
 private:
     /**
-     * Container storing all animation types
+     * Table storing all animation types, indexed by @a SpriteType
+     */
+    SpriteData m_configs[ST_NONE];
+    /**
+     * Source rectangles of frames; frames of one variant are stored one after another, variants of one animation as well
      */
-    std::map<SpriteType, SpriteData> m_configs;
+    std::vector<SDL_Rect> m_frames;
     /**
-     * Function used when adding a new animation type
-     * @param st - animation type
-     * @param x - horizontal position of the first animation frame in the texture
-     * @param y - vertical position of the first animation frame in the texture
-     * @param w - width of animation frames
-     * @param h - height of animation frames
-     * @param fc - number of frames in the animation
-     * @param fd - display time of one frame
-     * @param l - Animation looping
+     * Path of the atlas image named by the loaded manifest
      */
-    void insert(SpriteType st , int x, int y, int w, int h, int fc, int fd, bool l);
+    std::string m_texture_path;
 };
 
+inline const SDL_Rect *SpriteConfig::variantFrames(const SpriteData *sprite, int column, int first_row) const
+{
+    unsigned c = column - sprite->first_column;
+    if(c >= static_cast<unsigned>(sprite->columns) || first_row < 0 || first_row + sprite->frames_count > sprite->rows) return nullptr;
+    return &m_frames[sprite->first_frame + c * sprite->rows + first_row];
+}
+
 #endif // SPRITECONFIG_H
@@ -0,0 +1,211 @@
+#include "flowfield.h"
+#include "levelmap.h"
+#include "../appconfig.h"
+#include <algorithm>
+
+/**
+ * Steps between neighbouring positions in the order of @a Direction: up, right, down, left
+ */
+static const int step_x[4] = {0, 1, 0, -1};
+static const int step_y[4] = {-1, 0, 1, 0};
+
+FlowField::FlowField()
+{
+    m_origin = {0, 0};
+    m_columns = 0;
+    m_rows = 0;
+    m_target = {-1, -1};
+    // a step costs at most brick_cost + 1, so positions waiting for the search never wrap around onto the bucket being searched
+    m_buckets.resize(brick_cost + 2);
+}
+
+void FlowField::build(const LevelMap &map, SDL_Point target, int radius)
+{
+    int columns = std::max(map.columns() - 1, 0), rows = std::max(map.rows() - 1, 0);
+    m_target = target;
+    if(radius < 0)
+    {
+        m_origin = {0, 0};
+        m_columns = columns;
+        m_rows = rows;
+    }
+    else
+    {
+        m_origin = {std::max(target.x - radius, 0), std::max(target.y - radius, 0)};
+        m_columns = std::max(std::min(target.x + radius + 1, columns) - m_origin.x, 0);
+        m_rows = std::max(std::min(target.y + radius + 1, rows) - m_origin.y, 0);
+    }
+
+    m_kind.resize(m_columns * m_rows);
+    for(int j = 0; j < m_rows; j++)
+        for(int i = 0; i < m_columns; i++)
+            m_kind[j * m_columns + i] = positionKind(map, m_origin.x + i, m_origin.y + j);
+    m_cost.assign(m_kind.size(), -1);
+    m_next.assign(m_kind.size(), -1);
+
+    m_seeds.clear();
+    int x = target.x - m_origin.x, y = target.y - m_origin.y;
+    if(x >= 0 && y >= 0 && x < m_columns && y < m_rows)
+    {
+        m_cost[y * m_columns + x] = 0;
+        m_seeds.push_back(std::make_pair(0, y * m_columns + x));
+    }
+    propagate();
+}
+
+void FlowField::update(const LevelMap &map, int row, int column)
+{
+    if(m_kind.empty()) return;
+
+    row -= m_origin.y;
+    column -= m_origin.x;
+    int target = (m_target.y - m_origin.y) * m_columns + m_target.x - m_origin.x;
+    int cheaper[4], cheaper_count = 0;
+    m_invalid.clear();
+    m_seeds.clear();
+
+    // the cell belongs to the four positions of tanks overlapping it
+    for(int j = row - 1; j <= row; j++)
+    {
+        for(int i = column - 1; i <= column; i++)
+        {
+            if(i < 0 || j < 0 || i >= m_columns || j >= m_rows) continue;
+            int v = j * m_columns + i;
+            int kind = positionKind(map, m_origin.x + i, m_origin.y + j), previous = m_kind[v];
+            if(kind == previous) continue;
+            m_kind[v] = kind;
+
+            if(previous >= 0 && (kind < 0 || stepCost(kind) > stepCost(previous)))
+            {
+                // routes stepping into a dearer position may have better ways now; a closed position loses its own route as well
+                if(kind < 0 && v != target)
+                {
+                    m_cost[v] = -1;
+                    m_next[v] = -1;
+                    m_invalid.push_back(v);
+                }
+                else
+                    invalidateRoutesInto(v);
+            }
+            else
+                cheaper[cheaper_count++] = v;
+        }
+    }
+
+    for(unsigned k = 0; k < m_invalid.size(); k++)
+        invalidateRoutesInto(m_invalid[k]);
+    for(int v : m_invalid)
+        if(m_kind[v] >= 0) seedFromNeighbours(v);
+
+    // a cheaper or opened position offers better routes to its neighbours
+    for(int k = 0; k < cheaper_count; k++)
+    {
+        int v = cheaper[k];
+        if(m_cost[v] < 0) seedFromNeighbours(v);
+        else m_seeds.push_back(std::make_pair(m_cost[v], v));
+    }
+    propagate();
+}
+
+SDL_Point FlowField::target() const
+{
+    return m_target;
+}
+
+SDL_Point FlowField::positionOf(const SDL_Rect &rect)
+{
+    return {(rect.x + AppConfig::tile_rect.w / 2) / AppConfig::tile_rect.w, (rect.y + AppConfig::tile_rect.h / 2) / AppConfig::tile_rect.h};
+}
+
+int FlowField::positionKind(const LevelMap &map, int column, int row)
+{
+    int kind = 0;
+    for(int j = row; j < row + 2; j++)
+    {
+        for(int i = column; i < column + 2; i++)
+        {
+            Object* tile = map.tile(j, i);
+            if(tile == nullptr) continue;
+            if(tile->type == ST_STONE_WALL || tile->type == ST_WATER) return -1;
+            if(tile->type == ST_BRICK_WALL) kind = 1;
+        }
+    }
+    return kind;
+}
+
+void FlowField::invalidateRoutesInto(int position)
+{
+    int column = position % m_columns, row = position / m_columns;
+    for(int d = 0; d < 4; d++)
+    {
+        // the neighbour on the side d steps into the position in the opposite direction
+        int i = column + step_x[d], j = row + step_y[d];
+        if(i < 0 || j < 0 || i >= m_columns || j >= m_rows) continue;
+        int u = j * m_columns + i;
+        if(m_next[u] != (d + 2) % 4) continue;
+
+        m_cost[u] = -1;
+        m_next[u] = -1;
+        m_invalid.push_back(u);
+    }
+}
+
+void FlowField::seedFromNeighbours(int position)
+{
+    int column = position % m_columns, row = position / m_columns;
+    for(int d = 0; d < 4; d++)
+    {
+        int i = column + step_x[d], j = row + step_y[d];
+        if(i < 0 || j < 0 || i >= m_columns || j >= m_rows) continue;
+        int u = j * m_columns + i;
+        if(m_cost[u] < 0 || m_kind[u] < 0) continue;
+
+        int cost = m_cost[u] + stepCost(m_kind[u]);
+        if(m_cost[position] < 0 || cost < m_cost[position])
+        {
+            m_cost[position] = cost;
+            m_next[position] = d;
+        }
+    }
+    if(m_cost[position] >= 0) m_seeds.push_back(std::make_pair(m_cost[position], position));
+}
+
+void FlowField::propagate()
+{
+    std::sort(m_seeds.begin(), m_seeds.end());
+    int bucket_count = m_buckets.size();
+    unsigned next_seed = 0;
+    int pending = 0, cost = 0;
+    while(pending > 0 || next_seed < m_seeds.size())
+    {
+        if(pending == 0) cost = m_seeds[next_seed].first;
+        std::vector<int>& bucket = m_buckets[cost % bucket_count];
+        for(; next_seed < m_seeds.size() && m_seeds[next_seed].first == cost; next_seed++, pending++)
+            bucket.push_back(m_seeds[next_seed].second);
+
+        for(unsigned k = 0; k < bucket.size(); k++)
+        {
+            int v = bucket[k];
+            pending--;
+            // positions improved after they were queued are searched from their better cost
+            if(m_cost[v] != cost) continue;
+
+            int step = stepCost(m_kind[v]);
+            int column = v % m_columns, row = v / m_columns;
+            for(int d = 0; d < 4; d++)
+            {
+                int i = column + step_x[d], j = row + step_y[d];
+                if(i < 0 || j < 0 || i >= m_columns || j >= m_rows) continue;
+                int u = j * m_columns + i;
+                if(m_kind[u] < 0 || (m_cost[u] >= 0 && m_cost[u] <= cost + step)) continue;
+
+                m_cost[u] = cost + step;
+                m_next[u] = (d + 2) % 4;
+                m_buckets[(cost + step) % bucket_count].push_back(u);
+                pending++;
+            }
+        }
+        bucket.clear();
+        cost++;
+    }
+}
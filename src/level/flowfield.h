@@ -0,0 +1,148 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "../type.h"
+#include <SDL2/SDL.h>
+#include <utility>
+#include <vector>
+
+class LevelMap;
+
+/**
+ * @brief
+ * Class holds the direction of the cheapest route toward one target for every tank position of a map. A position is the top left cell of
+ * the 2x2 cells a tank takes; stone and water cannot be crossed, brick walls can, at the cost of @a brick_cost extra steps, because enemies
+ * shoot their way through them. The field is built once per target and repaired by @a update only around the cells that change, so any
+ * number of enemies read their next direction in constant time. A field may cover only a square around its target, which bounds the
+ * cost of building it on large maps; routes then stay inside the square and positions outside it have no direction.
+ */
+class FlowField
+{
+public:
+    /**
+     * Cost of a step into a position with brick walls in steps, besides the step itself
+     */
+    static const int brick_cost = 4;
+
+    FlowField();
+
+    /**
+     * Building the field toward a target
+     * @param map - map of the level
+     * @param target - tank position of the target (x - column, y - row)
+     * @param radius - largest distance of covered positions from the target in columns and rows; negative covers the whole map
+     */
+    void build(const LevelMap& map, SDL_Point target, int radius = -1);
+    /**
+     * Repairing the field after a cell of the map has changed; only routes passing the positions around the cell are searched again
+     * @param map - map of the level
+     * @param row - row of the changed cell
+     * @param column - column of the changed cell
+     */
+    void update(const LevelMap& map, int row, int column);
+    /**
+     * @return tank position of the target; (-1, -1) before the field is built
+     */
+    SDL_Point target() const;
+    /**
+     * @param column - column of a tank position
+     * @param row - row of a tank position
+     * @param direction - direction of the first step of the cheapest route
+     * @return @a false if the position is outside the map, it is the target or the target cannot be reached from it
+     */
+    inline bool direction(int column, int row, Direction& direction) const;
+    /**
+     * Finding the tank position nearest to a tank
+     * @param rect - rectangle of the tank in pixels
+     * @return position (x - column, y - row)
+     */
+    static SDL_Point positionOf(const SDL_Rect& rect);
+
+private:
+    /**
+     * @param map - map of the level
+     * @param column - column of a tank position in the map
+     * @param row - row of a tank position in the map
+     * @return 0 if the position is free, 1 if it holds brick walls, -1 if a tank cannot get there
+     */
+    static int positionKind(const LevelMap& map, int column, int row);
+    /**
+     * @param kind - kind of a position
+     * @return cost of a step into a position of the given kind
+     */
+    static inline int stepCost(int kind);
+    /**
+     * Clearing the routes of the positions whose first step leads into the given position and adding them to @a m_invalid
+     * @param position - index of a position
+     */
+    void invalidateRoutesInto(int position);
+    /**
+     * Finding the cheapest step from a position into one of its neighbours with a known route and making it a start of the search
+     * @param position - index of a position
+     */
+    void seedFromNeighbours(int position);
+    /**
+     * Searching routes from the positions in @a m_seeds in the order of their costs; the costs of steps are small,
+     * so the positions waiting for the search are kept in buckets of costs instead of a heap
+     */
+    void propagate();
+
+    /**
+     * Tank position of the top left corner of the covered square in the map; the other positions are counted from it
+     */
+    SDL_Point m_origin;
+    /**
+     * Number of columns of covered tank positions
+     */
+    int m_columns;
+    /**
+     * Number of rows of covered tank positions
+     */
+    int m_rows;
+    /**
+     * Tank position of the target
+     */
+    SDL_Point m_target;
+    /**
+     * Kind of each position (@a positionKind)
+     */
+    std::vector<Sint8> m_kind;
+    /**
+     * Cost of the cheapest route from each position to the target, -1 if there is none
+     */
+    std::vector<int> m_cost;
+    /**
+     * Direction of the first step from each position, -1 for the target and positions without a route
+     */
+    std::vector<Sint8> m_next;
+    /**
+     * Positions the search starts from together with their costs
+     */
+    std::vector< std::pair<int, int> > m_seeds;
+    /**
+     * Positions waiting for the search, by their cost modulo the number of buckets
+     */
+    std::vector< std::vector<int> > m_buckets;
+    /**
+     * Positions whose routes were invalidated by @a update
+     */
+    std::vector<int> m_invalid;
+};
+
+inline bool FlowField::direction(int column, int row, Direction &direction) const
+{
+    column -= m_origin.x;
+    row -= m_origin.y;
+    if(column < 0 || row < 0 || column >= m_columns || row >= m_rows) return false;
+    int next = m_next[row * m_columns + column];
+    if(next < 0) return false;
+    direction = static_cast<Direction>(next);
+    return true;
+}
+
+inline int FlowField::stepCost(int kind)
+{
+    return kind == 1 ? 1 + brick_cost : 1;
+}
+
+#endif // FLOWFIELD_H
@@ -0,0 +1,209 @@
+#include "levelanalyzer.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * Steps between neighbouring tank positions: up, down, left, right
+ */
+static const int step_x[4] = {0, 0, -1, 1};
+static const int step_y[4] = {-1, 1, 0, 0};
+
+bool LevelAnalyzer::analyze(const LevelData &level, LevelMetrics &metrics)
+{
+    int width = level.width(), height = level.height();
+    if(width < 2 || height < 2) return false;
+    metrics.width = width;
+    metrics.height = height;
+
+    unsigned counts[LT_COUNT] = {0};
+    for(int j = 0; j < height; j++)
+        for(int i = 0; i < width; i++)
+            counts[level.tile(j, i)]++;
+    for(int k = 0; k < LT_COUNT; k++)
+        metrics.density[k] = static_cast<double>(counts[k]) / (width * height);
+
+    m_columns = width - 1;
+    m_rows = height - 1;
+    m_kind.resize(m_columns * m_rows);
+    for(int j = 0; j < m_rows; j++)
+        for(int i = 0; i < m_columns; i++)
+            m_kind[j * m_columns + i] = positionKind(level, i, j);
+
+    findRoutes(level);
+    metrics.routes.clear();
+    for(const SDL_Point& spawn : level.enemySpawns())
+    {
+        SpawnRoute route = {spawn, -1, 0, 0};
+        int column = spawn.x / LevelData::tile_size, row = spawn.y / LevelData::tile_size;
+        if(column < m_columns && row < m_rows && m_cost[row * m_columns + column] >= 0)
+        {
+            int index = row * m_columns + column;
+            route.cost = m_cost[index];
+            route.steps = m_steps[index];
+            route.bricks = m_bricks[index];
+        }
+        metrics.routes.push_back(route);
+    }
+
+    metrics.choke_points = countChokePoints(level);
+    measureLanes(level, metrics);
+    return true;
+}
+
+void LevelAnalyzer::findRoutes(const LevelData &level)
+{
+    m_cost.assign(m_kind.size(), -1);
+    m_steps.assign(m_kind.size(), 0);
+    m_bricks.assign(m_kind.size(), 0);
+    m_heap.clear();
+
+    SDL_Point eagle = level.eagle();
+    if(eagle.x < 0 || eagle.y < 0 || eagle.x >= m_columns || eagle.y >= m_rows) return;
+
+    // Dijkstra from the eagle; a step from u into v costs as much as entering v, so costs are carried backwards from v to u
+    std::greater< std::pair<int, int> > later;
+    m_cost[eagle.y * m_columns + eagle.x] = 0;
+    m_heap.push_back(std::make_pair(0, eagle.y * m_columns + eagle.x));
+    while(!m_heap.empty())
+    {
+        std::pop_heap(m_heap.begin(), m_heap.end(), later);
+        int cost = m_heap.back().first, v = m_heap.back().second;
+        m_heap.pop_back();
+        if(cost > m_cost[v]) continue;
+
+        int step = 1 + (m_kind[v] == 1 ? brick_cost : 0);
+        int column = v % m_columns, row = v / m_columns;
+        for(int d = 0; d < 4; d++)
+        {
+            int i = column + step_x[d], j = row + step_y[d];
+            if(i < 0 || j < 0 || i >= m_columns || j >= m_rows) continue;
+            int u = j * m_columns + i;
+            if(m_kind[u] < 0 || (m_cost[u] >= 0 && m_cost[u] <= cost + step)) continue;
+
+            m_cost[u] = cost + step;
+            m_steps[u] = m_steps[v] + 1;
+            m_bricks[u] = m_bricks[v] + (m_kind[v] == 1 ? 1 : 0);
+            m_heap.push_back(std::make_pair(m_cost[u], u));
+            std::push_heap(m_heap.begin(), m_heap.end(), later);
+        }
+    }
+}
+
+int LevelAnalyzer::countChokePoints(const LevelData &level)
+{
+    m_discovery.assign(m_kind.size(), 0);
+    m_low.assign(m_kind.size(), 0);
+    m_flags.assign(m_kind.size(), 0);
+    m_stack.clear();
+
+    SDL_Point eagle = level.eagle();
+    if(eagle.x < 0 || eagle.y < 0 || eagle.x >= m_columns || eagle.y >= m_rows) return 0;
+    for(const SDL_Point& spawn : level.enemySpawns())
+    {
+        int column = spawn.x / LevelData::tile_size, row = spawn.y / LevelData::tile_size;
+        if(column < m_columns && row < m_rows) m_flags[row * m_columns + column] = 1;
+    }
+
+    // Iterative Tarjan search rooted at the eagle: a position separates a spawn point from the eagle
+    // if the subtree of one of its children contains the spawn point and has no edge above the position.
+    int time = 1, count = 0;
+    int root = eagle.y * m_columns + eagle.x;
+    m_discovery[root] = m_low[root] = time++;
+    m_stack.push_back(std::make_pair(root, 0));
+    while(!m_stack.empty())
+    {
+        int v = m_stack.back().first;
+        if(m_stack.back().second < 4)
+        {
+            int d = m_stack.back().second++;
+            int i = v % m_columns + step_x[d], j = v / m_columns + step_y[d];
+            if(i < 0 || j < 0 || i >= m_columns || j >= m_rows) continue;
+            int u = j * m_columns + i;
+            if(m_kind[u] < 0) continue;
+
+            if(m_discovery[u] == 0)
+            {
+                m_discovery[u] = m_low[u] = time++;
+                m_stack.push_back(std::make_pair(u, 0));
+            }
+            else if(m_stack.size() < 2 || u != m_stack[m_stack.size() - 2].first)
+                m_low[v] = std::min(m_low[v], m_discovery[u]);
+            continue;
+        }
+
+        m_stack.pop_back();
+        if(m_stack.empty()) break;
+        int parent = m_stack.back().first;
+        m_low[parent] = std::min(m_low[parent], m_low[v]);
+        m_flags[parent] |= m_flags[v] & 1;
+        if(m_stack.size() > 1 && (m_flags[v] & 1) && !(m_flags[parent] & 2) && m_low[v] >= m_discovery[parent])
+        {
+            m_flags[parent] |= 2;
+            count++;
+        }
+    }
+    return count;
+}
+
+void LevelAnalyzer::measureLanes(const LevelData &level, LevelMetrics &metrics)
+{
+    metrics.open_lanes = 0;
+    metrics.lane_cells = 0;
+    metrics.lane_cells_without_bricks = 0;
+
+    SDL_Point eagle = level.eagle();
+    for(int d = 0; d < 4; d++)
+    {
+        for(int k = 0; k < 2; k++)
+        {
+            // lanes start next to the eagle and are as wide as the eagle
+            int column, row;
+            if(step_x[d] == 0)
+            {
+                column = eagle.x + k;
+                row = step_y[d] < 0 ? eagle.y - 1 : eagle.y + 2;
+            }
+            else
+            {
+                row = eagle.y + k;
+                column = step_x[d] < 0 ? eagle.x - 1 : eagle.x + 2;
+            }
+
+            bool clear = true, blocked = false;
+            int length = 0;
+            for(; column >= 0 && row >= 0 && column < level.width() && row < level.height(); column += step_x[d], row += step_y[d])
+            {
+                LevelTile tile = level.tile(row, column);
+                length++;
+                if(tile == LT_STONE)
+                {
+                    blocked = true;
+                    break;
+                }
+                if(tile == LT_BRICK)
+                {
+                    clear = false;
+                    continue;
+                }
+                if(clear) metrics.lane_cells++;
+                metrics.lane_cells_without_bricks++;
+            }
+            if(clear && !blocked && length > 0) metrics.open_lanes++;
+        }
+    }
+}
+
+int LevelAnalyzer::positionKind(const LevelData &level, int column, int row)
+{
+    int kind = 0;
+    for(int j = row; j < row + 2; j++)
+    {
+        for(int i = column; i < column + 2; i++)
+        {
+            LevelTile tile = level.tile(j, i);
+            if(tile == LT_STONE || tile == LT_WATER) return -1;
+            if(tile == LT_BRICK) kind = 1;
+        }
+    }
+    return kind;
+}
@@ -0,0 +1,167 @@
+#ifndef LEVELANALYZER_H
+#define LEVELANALYZER_H
+
+#include "leveldata.h"
+#include <SDL2/SDL.h>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief
+ * Route of enemies from one spawn point to the eagle found by @a LevelAnalyzer
+ */
+struct SpawnRoute
+{
+    /**
+     * Spawn point in pixels
+     */
+    SDL_Point spawn;
+    /**
+     * Cost of the cheapest route: one per step of a tile plus @a LevelAnalyzer::brick_cost for every step into brick walls; -1 if the eagle cannot be reached
+     */
+    int cost;
+    /**
+     * Number of steps of the cheapest route
+     */
+    int steps;
+    /**
+     * Number of steps of the cheapest route through brick walls
+     */
+    int bricks;
+};
+
+/**
+ * @brief
+ * Navigation and difficulty metrics of a level
+ */
+struct LevelMetrics
+{
+    /**
+     * Number of columns
+     */
+    int width;
+    /**
+     * Number of rows
+     */
+    int height;
+    /**
+     * Shares of cells holding each kind of @a LevelTile
+     */
+    double density[LT_COUNT];
+    /**
+     * Routes from the enemy spawn points in the order of @a LevelData::enemySpawns
+     */
+    std::vector<SpawnRoute> routes;
+    /**
+     * Number of tank positions every route from some enemy spawn point to the eagle has to pass
+     */
+    int choke_points;
+    /**
+     * Number of the eight lanes (two cells wide in each direction) leading from the eagle to the border of the map without a brick or stone wall
+     */
+    int open_lanes;
+    /**
+     * Number of cells in the lanes of the eagle from which a bullet reaches the eagle
+     */
+    int lane_cells;
+    /**
+     * Number of cells in the lanes of the eagle from which a bullet reaches the eagle once all brick walls are destroyed
+     */
+    int lane_cells_without_bricks;
+};
+
+/**
+ * @brief
+ * Class computes navigation metrics of levels for tuning the difficulty offline. A tank is treated as 2x2 cells moving by single cells;
+ * stone and water stop it, brick walls only slow it down, because it can shoot through them. An analyzer keeps its buffers between
+ * levels, so one analyzer per thread can process many levels without allocating.
+ */
+class LevelAnalyzer
+{
+public:
+    /**
+     * Cost of a step into a position with brick walls, in steps; a tank stops and shoots before it moves on
+     */
+    static const int brick_cost = 4;
+
+    /**
+     * Computing the metrics of a level
+     * @param level - loaded level
+     * @param metrics - computed metrics
+     * @return @a false if the level is empty
+     */
+    bool analyze(const LevelData& level, LevelMetrics& metrics);
+
+private:
+    /**
+     * Finding the cheapest routes from all tank positions to the eagle into @a m_cost, @a m_steps and @a m_bricks
+     * @param level - analyzed level
+     */
+    void findRoutes(const LevelData& level);
+    /**
+     * Counting positions that separate an enemy spawn point from the eagle (articulation points of the graph of tank positions)
+     * @param level - analyzed level
+     * @return number of the positions
+     */
+    int countChokePoints(const LevelData& level);
+    /**
+     * Measuring the lanes of the eagle
+     * @param level - analyzed level
+     * @param metrics - metrics receiving @a LevelMetrics::open_lanes, @a LevelMetrics::lane_cells and @a LevelMetrics::lane_cells_without_bricks
+     */
+    static void measureLanes(const LevelData& level, LevelMetrics& metrics);
+    /**
+     * @param level - analyzed level
+     * @param column - column of the top left cell of a tank
+     * @param row - row of the top left cell of a tank
+     * @return 0 if the position is free, 1 if it holds brick walls, -1 if a tank cannot get there
+     */
+    static int positionKind(const LevelData& level, int column, int row);
+
+    /**
+     * Number of columns of tank positions of the analyzed level
+     */
+    int m_columns;
+    /**
+     * Number of rows of tank positions of the analyzed level
+     */
+    int m_rows;
+    /**
+     * Kind of each tank position (@a positionKind)
+     */
+    std::vector<Sint8> m_kind;
+    /**
+     * Cost of the cheapest route from each position to the eagle, -1 if there is none
+     */
+    std::vector<int> m_cost;
+    /**
+     * Number of steps of the cheapest route from each position
+     */
+    std::vector<int> m_steps;
+    /**
+     * Number of steps into brick walls on the cheapest route from each position
+     */
+    std::vector<int> m_bricks;
+    /**
+     * Heap of the route search (cost, position)
+     */
+    std::vector< std::pair<int, int> > m_heap;
+    /**
+     * Stack of the depth-first search for choke points (position, next direction)
+     */
+    std::vector< std::pair<int, int> > m_stack;
+    /**
+     * Discovery times of the depth-first search for choke points, 0 for positions not visited
+     */
+    std::vector<int> m_discovery;
+    /**
+     * Lowest discovery time reachable from the subtree of each position
+     */
+    std::vector<int> m_low;
+    /**
+     * Flags of each position of the depth-first search: bit 0 - the subtree contains an enemy spawn point, bit 1 - the position is a counted choke point
+     */
+    std::vector<Uint8> m_flags;
+};
+
+#endif // LEVELANALYZER_H
@@ -0,0 +1,247 @@
+#include "leveldata.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+static const char level_magic[4] = {'T', 'N', 'K', 'L'};
+static const Uint32 level_version = 1;
+/**
+ * Size of the header of a compiled level in bytes
+ */
+static const size_t header_size = 20;
+
+static void writeValue(std::vector<Uint8>& data, Uint32 value, int size)
+{
+    for(int i = 0; i < size; i++)
+        data.push_back(value >> (8 * i));
+}
+
+static Uint32 readValue(const Uint8* data, int size)
+{
+    Uint32 value = 0;
+    for(int i = 0; i < size; i++)
+        value |= static_cast<Uint32>(data[i]) << (8 * i);
+    return value;
+}
+
+static Uint32 checksum(const Uint8* data, size_t size)
+{
+    Uint32 h = 2166136261U;
+    for(size_t i = 0; i < size; i++)
+    {
+        h ^= data[i];
+        h *= 16777619U;
+    }
+    return h;
+}
+
+LevelData::LevelData()
+{
+    clear();
+}
+
+bool LevelData::compile(const std::string &text, std::vector<Uint8> &data)
+{
+    std::vector<std::string> rows;
+    std::istringstream input(text);
+    std::string line;
+    while(std::getline(input, line))
+    {
+        if(!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        rows.push_back(line);
+    }
+    while(!rows.empty() && rows.back().empty()) rows.pop_back();
+
+    int height = rows.size();
+    int width = height > 0 ? rows.front().size() : 0;
+    if(width < 2 || height < 2 || width > max_size || height > max_size) return false;
+
+    std::vector<Uint8> tiles(width * height);
+    std::vector<SDL_Point> players, enemies;
+    for(int j = 0; j < height; j++)
+    {
+        if(static_cast<int>(rows[j].size()) != width) return false;
+        for(int i = 0; i < width; i++)
+        {
+            Uint8& tile = tiles[j * width + i];
+            switch(rows[j][i])
+            {
+            case '.' : tile = LT_EMPTY; break;
+            case '#' : tile = LT_BRICK; break;
+            case '@' : tile = LT_STONE; break;
+            case '%' : tile = LT_BUSH; break;
+            case '~' : tile = LT_WATER; break;
+            case '-' : tile = LT_ICE; break;
+            case 'P' : tile = LT_EMPTY; players.push_back({i * tile_size, j * tile_size}); break;
+            case 'E' : tile = LT_EMPTY; enemies.push_back({i * tile_size, j * tile_size}); break;
+            default: return false;
+            }
+        }
+    }
+
+    // The eagle stands in the middle of the bottom of the map, its spot is cleared.
+    // Without spawn markers the tanks start as in the original game.
+    if(players.size() == 1 || players.size() > 0xff || enemies.size() > 0xff) return false;
+    SDL_Point eagle;
+    std::vector<SDL_Point> default_players, default_enemies;
+    defaultPlacement(width, height, eagle, default_players, default_enemies);
+    for(int j = eagle.y; j < eagle.y + 2; j++)
+        for(int i = eagle.x; i < eagle.x + 2; i++)
+            tiles[j * width + i] = LT_EMPTY;
+    if(players.empty()) players.swap(default_players);
+    if(enemies.empty()) enemies.swap(default_enemies);
+
+    data.clear();
+    data.reserve(header_size + tiles.size() + 4 * (players.size() + enemies.size()) + 4);
+    for(char c : level_magic)
+        data.push_back(c);
+    writeValue(data, level_version, 4);
+    writeValue(data, width, 2);
+    writeValue(data, height, 2);
+    writeValue(data, eagle.x, 2);
+    writeValue(data, eagle.y, 2);
+    writeValue(data, players.size(), 1);
+    writeValue(data, enemies.size(), 1);
+    writeValue(data, 0, 2);
+    data.insert(data.end(), tiles.begin(), tiles.end());
+    for(const SDL_Point& point : players)
+    {
+        writeValue(data, point.x, 2);
+        writeValue(data, point.y, 2);
+    }
+    for(const SDL_Point& point : enemies)
+    {
+        writeValue(data, point.x, 2);
+        writeValue(data, point.y, 2);
+    }
+    writeValue(data, checksum(data.data(), data.size()), 4);
+    return true;
+}
+
+void LevelData::defaultPlacement(int width, int height, SDL_Point &eagle, std::vector<SDL_Point> &players, std::vector<SDL_Point> &enemies)
+{
+    eagle = {width / 2 - 1, height - 2};
+    players = {{std::max(width / 2 - 5, 0) * tile_size, (height - 2) * tile_size},
+               {std::min(width / 2 + 3, width - 2) * tile_size, (height - 2) * tile_size}};
+    enemies = {{1, 1}, {(width / 2 - 1) * tile_size, 1}, {(width - 2) * tile_size, 1}};
+}
+
+bool LevelData::load(const std::string &path)
+{
+    clear();
+    if(!m_file.open(path)) return false;
+    if(attach(m_file.data(), m_file.size())) return true;
+    m_file.close();
+    return false;
+}
+
+bool LevelData::loadText(const std::string &path)
+{
+    clear();
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    if(!file.is_open()) return false;
+
+    std::ostringstream text;
+    text << file.rdbuf();
+    return loadFromText(text.str());
+}
+
+bool LevelData::loadFromText(const std::string &text)
+{
+    clear();
+    std::vector<Uint8> compiled;
+    if(!compile(text, compiled)) return false;
+
+    // attach clears the level, so the compiled data is moved in afterwards; the buffer itself stays the same
+    const Uint8* data = compiled.data();
+    size_t size = compiled.size();
+    if(!attach(data, size)) return false;
+    m_compiled.swap(compiled);
+    return true;
+}
+
+bool LevelData::attach(const Uint8 *data, size_t size)
+{
+    if(data != m_file.data()) m_file.close();
+    m_compiled.clear();
+    m_tiles = nullptr;
+    m_width = m_height = 0;
+    m_player_spawns.clear();
+    m_enemy_spawns.clear();
+
+    if(size < header_size + 4 || memcmp(data, level_magic, sizeof(level_magic)) != 0 || readValue(data + 4, 4) != level_version) return false;
+
+    int width = readValue(data + 8, 2);
+    int height = readValue(data + 10, 2);
+    SDL_Point eagle = {static_cast<int>(readValue(data + 12, 2)), static_cast<int>(readValue(data + 14, 2))};
+    unsigned players_count = data[16], enemies_count = data[17];
+    size_t tiles_count = static_cast<size_t>(width) * height;
+
+    if(width == 0 || height == 0 || width > max_size || height > max_size || eagle.x + 2 > width || eagle.y + 2 > height || players_count < 2 || enemies_count == 0 ||
+       size != header_size + tiles_count + 4 * (players_count + enemies_count) + 4 ||
+       readValue(data + size - 4, 4) != checksum(data, size - 4))
+        return false;
+
+    const Uint8* tiles = data + header_size;
+    for(size_t i = 0; i < tiles_count; i++)
+        if(tiles[i] >= LT_COUNT) return false;
+
+    const Uint8* point = tiles + tiles_count;
+    for(unsigned i = 0; i < players_count + enemies_count; i++, point += 4)
+    {
+        SDL_Point p = {static_cast<int>(readValue(point, 2)), static_cast<int>(readValue(point + 2, 2))};
+        // spawn points are in pixels, a tank covers 2x2 tiles like the eagle
+        if(p.x + 2 * tile_size > width * tile_size || p.y + 2 * tile_size > height * tile_size)
+        {
+            m_player_spawns.clear();
+            m_enemy_spawns.clear();
+            return false;
+        }
+        if(i < players_count) m_player_spawns.push_back(p);
+        else m_enemy_spawns.push_back(p);
+    }
+
+    m_tiles = tiles;
+    m_width = width;
+    m_height = height;
+    m_eagle = eagle;
+    return true;
+}
+
+void LevelData::clear()
+{
+    m_file.close();
+    m_compiled.clear();
+    m_tiles = nullptr;
+    m_width = 0;
+    m_height = 0;
+    m_eagle = {0, 0};
+    m_player_spawns.clear();
+    m_enemy_spawns.clear();
+}
+
+int LevelData::width() const
+{
+    return m_width;
+}
+
+int LevelData::height() const
+{
+    return m_height;
+}
+
+SDL_Point LevelData::eagle() const
+{
+    return m_eagle;
+}
+
+const std::vector<SDL_Point> &LevelData::playerSpawns() const
+{
+    return m_player_spawns;
+}
+
+const std::vector<SDL_Point> &LevelData::enemySpawns() const
+{
+    return m_enemy_spawns;
+}
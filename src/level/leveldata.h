@@ -0,0 +1,177 @@
+#ifndef LEVELDATA_H
+#define LEVELDATA_H
+
+#include "mappedfile.h"
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * Content of a map cell stored in a compiled level
+ */
+enum LevelTile : Uint8
+{
+    LT_EMPTY,
+    LT_BRICK,
+    LT_STONE,
+    LT_BUSH,
+    LT_WATER,
+    LT_ICE,
+
+    LT_COUNT
+};
+
+/**
+ * @brief
+ * Class gives access to a compiled level: tiles of the map, spawn points and the position of the eagle. A compiled file is mapped into memory
+ * and used in place, tiles are read directly from the mapping. Text levels are compiled in memory first, so both are served the same way.
+ *
+ * Compiled format (little-endian): header "TNKL", version (4 bytes), width, height, eagle column, eagle row (2 bytes each),
+ * number of player spawn points, number of enemy spawn points (1 byte each), 2 reserved bytes; then one byte per tile (@a LevelTile) row after row,
+ * spawn points of players and enemies (x 2, y 2 bytes in pixels) and the FNV-1a checksum of all previous bytes (4 bytes).
+ *
+ * Text format: one line per row, one character per cell:
+ * @li . - empty field
+ * @li # - brick wall
+ * @li @ - stone
+ * @li % - bushes
+ * @li ~ - water
+ * @li - - ice
+ * @li P - empty field where a player starts; the first marker in reading order is the first player, at least two markers are needed
+ * @li E - empty field where enemies appear, used in reading order
+ *
+ * Levels without markers place the players and the enemies as in the original game.
+ */
+class LevelData
+{
+public:
+    /**
+     * Maximum number of rows and columns of a level
+     */
+    static const int max_size = 512;
+    /**
+     * Size of a tile in pixels, the same as @a AppConfig::tile_rect; spawn points are given in pixels
+     */
+    static const int tile_size = 16;
+
+    LevelData();
+
+    /**
+     * Compiling a text level; the eagle and spawn points without markers are placed as in the original game
+     * @param text - content of a text level
+     * @param data - compiled level
+     * @return @a false if the text is not a rectangular map of known characters, is larger than @a max_size or has a wrong number of spawn markers
+     */
+    static bool compile(const std::string& text, std::vector<Uint8>& data);
+    /**
+     * Placement used by levels without spawn markers, as in the original game
+     * @param width - number of columns of the map
+     * @param height - number of rows of the map
+     * @param eagle - cell of the top left corner of the eagle (x - column, y - row)
+     * @param players - starting points of players in pixels
+     * @param enemies - starting points of enemies in pixels
+     */
+    static void defaultPlacement(int width, int height, SDL_Point& eagle, std::vector<SDL_Point>& players, std::vector<SDL_Point>& enemies);
+    /**
+     * Mapping a compiled level file
+     * @param path - path of the file
+     * @return @a false if the file could not be mapped or is not a valid level
+     */
+    bool load(const std::string& path);
+    /**
+     * Reading and compiling a text level file
+     * @param path - path of the file
+     * @return @a false if the file could not be read or is not a valid level
+     */
+    bool loadText(const std::string& path);
+    /**
+     * Compiling a text level kept in memory, e.g. a generated one
+     * @param text - content of a text level
+     * @return @a false if the text is not a valid level
+     */
+    bool loadFromText(const std::string& text);
+    /**
+     * Using a compiled level kept in memory by the caller; the memory has to stay valid as long as the level is used.
+     * A valid level has spawn points of both players and at least one spawn point of enemies, and the eagle and every tank placed
+     * on a spawn point, 2x2 tiles each, lie inside the map.
+     * @param data - first byte of the level
+     * @param size - size of the level in bytes
+     * @return @a false if the data is not a valid level
+     */
+    bool attach(const Uint8* data, size_t size);
+    /**
+     * Forgetting the level and releasing its file
+     */
+    void clear();
+
+    /**
+     * @return number of columns of the map
+     */
+    int width() const;
+    /**
+     * @return number of rows of the map
+     */
+    int height() const;
+    /**
+     * @param row - row of the cell
+     * @param column - column of the cell
+     * @return content of the cell
+     */
+    inline LevelTile tile(int row, int column) const;
+    /**
+     * @return cell of the top left corner of the eagle (x - column, y - row)
+     */
+    SDL_Point eagle() const;
+    /**
+     * @return starting points of players in pixels
+     */
+    const std::vector<SDL_Point>& playerSpawns() const;
+    /**
+     * @return starting points of enemies in pixels
+     */
+    const std::vector<SDL_Point>& enemySpawns() const;
+
+private:
+    LevelData(const LevelData&);
+    LevelData& operator=(const LevelData&);
+
+    /**
+     * Mapped compiled file
+     */
+    MappedFile m_file;
+    /**
+     * Level compiled from a text file
+     */
+    std::vector<Uint8> m_compiled;
+    /**
+     * Tiles of the map, row after row
+     */
+    const Uint8* m_tiles;
+    /**
+     * Number of columns
+     */
+    int m_width;
+    /**
+     * Number of rows
+     */
+    int m_height;
+    /**
+     * Cell of the eagle
+     */
+    SDL_Point m_eagle;
+    /**
+     * Starting points of players
+     */
+    std::vector<SDL_Point> m_player_spawns;
+    /**
+     * Starting points of enemies
+     */
+    std::vector<SDL_Point> m_enemy_spawns;
+};
+
+inline LevelTile LevelData::tile(int row, int column) const
+{
+    return static_cast<LevelTile>(m_tiles[row * m_width + column]);
+}
+
+#endif // LEVELDATA_H
@@ -0,0 +1,167 @@
+#include "levelgenerator.h"
+
+/**
+ * Characters of the text format in the order of @a LevelTile
+ */
+static const char tile_symbols[LT_COUNT] = {'.', '#', '@', '%', '~', '-'};
+
+LevelGenerator::LevelGenerator(const Settings &settings)
+{
+    m_settings = settings;
+    m_state = 1;
+    m_rejected = 0;
+}
+
+bool LevelGenerator::generate(Uint32 seed, std::string &text)
+{
+    int width = m_settings.width, height = m_settings.height;
+    if(width < 6 || height < 6 || width > LevelData::max_size || height > LevelData::max_size) return false;
+
+    // neighbouring seeds are spread over the whole state space; the state of xorshift must not be zero
+    m_state = seed * 2654435761U ^ 0x9e3779b9U;
+    if(m_state == 0) m_state = 1;
+    next();
+
+    for(int attempt = 0; attempt < m_settings.attempts; attempt++)
+    {
+        fill();
+        if(!validate(m_tiles, width, height))
+        {
+            m_rejected++;
+            continue;
+        }
+
+        text.resize((width + 1) * height);
+        for(int j = 0; j < height; j++)
+        {
+            for(int i = 0; i < width; i++)
+                text[j * (width + 1) + i] = tile_symbols[m_tiles[j * width + i]];
+            text[j * (width + 1) + width] = '\n';
+        }
+        return true;
+    }
+    return false;
+}
+
+bool LevelGenerator::validate(const std::vector<Uint8> &tiles, int width, int height)
+{
+    if(width < 2 || height < 2 || tiles.size() != static_cast<size_t>(width * height)) return false;
+
+    SDL_Point eagle;
+    std::vector<SDL_Point> players, enemies;
+    LevelData::defaultPlacement(width, height, eagle, players, enemies);
+
+    // the eagle and tanks take 2x2 cells
+    auto clear = [&tiles, width, height](int column, int row)
+    {
+        if(column < 0 || row < 0 || column + 2 > width || row + 2 > height) return false;
+        for(int j = row; j < row + 2; j++)
+            for(int i = column; i < column + 2; i++)
+                if(tiles[j * width + i] != LT_EMPTY) return false;
+        return true;
+    };
+    if(!clear(eagle.x, eagle.y)) return false;
+    for(const SDL_Point& spawn : players)
+        if(!clear(spawn.x / LevelData::tile_size, spawn.y / LevelData::tile_size)) return false;
+    for(const SDL_Point& spawn : enemies)
+        if(!clear(spawn.x / LevelData::tile_size, spawn.y / LevelData::tile_size)) return false;
+
+    // an almost empty map is no stage
+    int obstacles = 0;
+    for(Uint8 tile : tiles)
+        if(tile != LT_EMPTY) obstacles++;
+    if(obstacles * 10 < width * height) return false;
+
+    // Flood fill over the positions of the top left cell of a tank, starting from the eagle. Brick walls can be shot through,
+    // stone and water stop the tank; bushes and ice do not matter.
+    int columns = width - 1, rows = height - 1;
+    auto passable = [&tiles, width](int column, int row)
+    {
+        for(int j = row; j < row + 2; j++)
+            for(int i = column; i < column + 2; i++)
+                if(tiles[j * width + i] == LT_STONE || tiles[j * width + i] == LT_WATER) return false;
+        return true;
+    };
+
+    m_reached.assign(columns * rows, 0);
+    m_queue.clear();
+    m_queue.push_back(eagle.y * columns + eagle.x);
+    m_reached[m_queue.back()] = 1;
+    for(unsigned head = 0; head < m_queue.size(); head++)
+    {
+        int column = m_queue[head] % columns, row = m_queue[head] / columns;
+        const SDL_Point neighbours[4] = {{column - 1, row}, {column + 1, row}, {column, row - 1}, {column, row + 1}};
+        for(const SDL_Point& n : neighbours)
+        {
+            if(n.x < 0 || n.y < 0 || n.x >= columns || n.y >= rows) continue;
+            Uint8& reached = m_reached[n.y * columns + n.x];
+            if(reached || !passable(n.x, n.y)) continue;
+            reached = 1;
+            m_queue.push_back(n.y * columns + n.x);
+        }
+    }
+
+    for(const SDL_Point& spawn : enemies)
+        if(!m_reached[spawn.y / LevelData::tile_size * columns + spawn.x / LevelData::tile_size]) return false;
+
+    // a map mostly closed by stone and water is no stage either
+    return m_queue.size() * 5 >= static_cast<size_t>(columns * rows) * 2;
+}
+
+unsigned LevelGenerator::rejected() const
+{
+    return m_rejected;
+}
+
+void LevelGenerator::fill()
+{
+    int width = m_settings.width, height = m_settings.height;
+    int half = (width + 1) / 2;
+    m_tiles.assign(width * height, LT_EMPTY);
+
+    for(int y = 0; y < height; y += 2)
+        for(int x = 0; x < half; x += 2)
+        {
+            if(uniform() >= m_settings.density) continue;
+
+            double kind = uniform();
+            LevelTile tile = LT_BRICK;
+            if(kind < m_settings.stone) tile = LT_STONE;
+            else if(kind < m_settings.stone + m_settings.water) tile = LT_WATER;
+            else if(kind < m_settings.stone + m_settings.water + 0.1) tile = LT_BUSH;
+            else if(kind < m_settings.stone + m_settings.water + 0.15) tile = LT_ICE;
+
+            // half of the blocks are full, the other ones are the thin walls of the original stages
+            unsigned shape = next() % 8;
+            for(int j = 0; j < 2; j++)
+                for(int i = 0; i < 2; i++)
+                {
+                    if((shape == 0 && j == 1) || (shape == 1 && j == 0) || (shape == 2 && i == 1) || (shape == 3 && i == 0)) continue;
+                    if(y + j < height && x + i < half) setMirrored(y + j, x + i, tile);
+                }
+        }
+
+    SDL_Point eagle;
+    std::vector<SDL_Point> players, enemies;
+    LevelData::defaultPlacement(width, height, eagle, players, enemies);
+
+    // brick wall around the eagle, like in the original stages
+    for(int j = eagle.y - 1; j < eagle.y + 2; j++)
+        for(int i = eagle.x - 1; i < eagle.x + 3; i++)
+            if(j >= 0 && i >= 0 && j < height && i < width) m_tiles[j * width + i] = LT_BRICK;
+
+    std::vector<SDL_Point> cleared = {eagle};
+    for(const SDL_Point& spawn : players) cleared.push_back({spawn.x / LevelData::tile_size, spawn.y / LevelData::tile_size});
+    for(const SDL_Point& spawn : enemies) cleared.push_back({spawn.x / LevelData::tile_size, spawn.y / LevelData::tile_size});
+    for(const SDL_Point& cell : cleared)
+        for(int j = cell.y; j < cell.y + 2 && j < height; j++)
+            for(int i = cell.x; i < cell.x + 2 && i < width; i++)
+                m_tiles[j * width + i] = LT_EMPTY;
+}
+
+void LevelGenerator::setMirrored(int row, int column, LevelTile tile)
+{
+    int width = m_settings.width;
+    m_tiles[row * width + column] = tile;
+    m_tiles[row * width + width - 1 - column] = tile;
+}
@@ -0,0 +1,140 @@
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include "leveldata.h"
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Class generates text levels from a seed. The same seed and settings give the same level on every platform, because the generator
+ * uses its own random number generator instead of @a rand, which also keeps the random sequence of the game untouched.
+ *
+ * A layout is built from 2x2 blocks mirrored around the vertical axis like the original stages, the eagle gets a brick wall and
+ * the spawn points of the original game (@a LevelData::defaultPlacement) are cleared. A layout is accepted by @a validate only if
+ * a tank can drive from every enemy spawn point to the eagle; rejected layouts are replaced with the next ones drawn from the same seed.
+ */
+class LevelGenerator
+{
+public:
+    /**
+     * @brief
+     * Parameters of generated levels
+     */
+    struct Settings
+    {
+        Settings(): width(26), height(26), density(0.35), stone(0.1), water(0.08), attempts(64) {}
+        /**
+         * Number of columns, from 6 to @a LevelData::max_size
+         */
+        int width;
+        /**
+         * Number of rows, from 6 to @a LevelData::max_size
+         */
+        int height;
+        /**
+         * Share of blocks holding an obstacle, from 0 to 1
+         */
+        double density;
+        /**
+         * Share of obstacle blocks made of stone
+         */
+        double stone;
+        /**
+         * Share of obstacle blocks made of water
+         */
+        double water;
+        /**
+         * Number of layouts tried for one seed before giving up
+         */
+        int attempts;
+    };
+
+    /**
+     * @param settings - parameters of generated levels
+     */
+    LevelGenerator(const Settings& settings = Settings());
+
+    /**
+     * Generating a level
+     * @param seed - seed of the level
+     * @param text - generated level in the text format of @a LevelData
+     * @return @a false if no valid layout was found within @a Settings::attempts tries or the settings are out of range
+     */
+    bool generate(Uint32 seed, std::string& text);
+    /**
+     * Checking a layout: the eagle and all spawn points have to be clear, a tank has to be able to reach the eagle from every enemy spawn point
+     * (brick walls can be shot through, stone and water cannot), and the map must be neither almost empty nor mostly closed.
+     * @param tiles - cells of the map (@a LevelTile) in row order
+     * @param width - number of columns
+     * @param height - number of rows
+     * @return @a true if the layout is a playable level
+     */
+    bool validate(const std::vector<Uint8>& tiles, int width, int height);
+    /**
+     * @return number of layouts rejected since the generator was created
+     */
+    unsigned rejected() const;
+
+private:
+    /**
+     * @return next number of the random sequence (xorshift32)
+     */
+    inline Uint32 next();
+    /**
+     * @return next number of the random sequence from the range [0, 1)
+     */
+    inline double uniform();
+    /**
+     * Drawing a new layout into @a m_tiles
+     */
+    void fill();
+    /**
+     * Setting a cell and its mirror image
+     * @param row - row of the cell
+     * @param column - column of the cell in the left half of the map
+     * @param tile - content of the cell
+     */
+    void setMirrored(int row, int column, LevelTile tile);
+
+    /**
+     * Parameters of generated levels
+     */
+    Settings m_settings;
+    /**
+     * State of the random number generator
+     */
+    Uint32 m_state;
+    /**
+     * Cells of the layout being generated
+     */
+    std::vector<Uint8> m_tiles;
+    /**
+     * Tank positions reached by the flood fill; reused by every validation
+     */
+    std::vector<Uint8> m_reached;
+    /**
+     * Queue of the flood fill; reused by every validation
+     */
+    std::vector<int> m_queue;
+    /**
+     * Number of rejected layouts
+     */
+    unsigned m_rejected;
+};
+
+inline Uint32 LevelGenerator::next()
+{
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 17;
+    m_state ^= m_state << 5;
+    return m_state;
+}
+
+inline double LevelGenerator::uniform()
+{
+    return next() / 4294967296.0;
+}
+
+#endif // LEVELGENERATOR_H
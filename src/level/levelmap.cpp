@@ -0,0 +1,262 @@
+#include "levelmap.h"
+#include "levelgenerator.h"
+#include "../appconfig.h"
+#include <algorithm>
+
+LevelMap::LevelMap()
+{
+    m_number = 0;
+    m_chunk_columns = 0;
+    m_row_words = 0;
+    m_column_words = 0;
+}
+
+bool LevelMap::load(int number)
+{
+    m_number = number;
+    m_chunks.clear();
+    m_terrain.clear();
+
+    std::string path = AppConfig::levels_path + Engine::intToString(number);
+    bool loaded = Engine::getEngine().getLevelPack()->level(number, m_data) || m_data.load(path + ".lvl") || m_data.loadText(path);
+    if(!loaded && AppConfig::endless_levels && number > 0)
+    {
+        // levels after the designed ones are generated from their number, so every run plays the same endless sequence
+        LevelGenerator::Settings settings;
+        settings.density = std::min(0.3 + 0.005 * number, 0.6);
+        LevelGenerator generator(settings);
+        std::string text;
+        loaded = generator.generate(number, text) && m_data.loadFromText(text);
+    }
+
+    int rows = m_data.height(), columns = m_data.width();
+    m_chunk_columns = (columns + chunk_size - 1) / chunk_size;
+    m_chunks.resize(m_chunk_columns * ((rows + chunk_size - 1) / chunk_size));
+    const int terrain_size = RenderCommandBuffer::terrain_chunk_size;
+    int terrain_columns = (columns + terrain_size - 1) / terrain_size;
+    m_terrain.assign(terrain_columns * ((rows + terrain_size - 1) / terrain_size),
+                     TerrainChunk{std::vector<SDL_Rect>(terrain_size * terrain_size, SDL_Rect{0, 0, 0, 0}), 0, 0});
+    m_row_words = (columns + 63) / 64;
+    m_column_words = (rows + 63) / 64;
+    m_row_walls.assign(rows * m_row_words, 0);
+    m_column_walls.assign(columns * m_column_words, 0);
+
+    // the pools are sized to the content of each chunk first, so building the map does not move any object
+    std::vector<unsigned> bricks(m_chunks.size(), 0), bushes(m_chunks.size(), 0), obstacles(m_chunks.size(), 0);
+    for(int j = 0; j < rows; j++)
+    {
+        for(int i = 0; i < columns; i++)
+        {
+            unsigned index = j / chunk_size * m_chunk_columns + i / chunk_size;
+            switch(m_data.tile(j, i))
+            {
+            case LT_EMPTY: break;
+            case LT_BRICK: bricks[index]++; break;
+            case LT_BUSH: bushes[index]++; break;
+            default: obstacles[index]++; break;
+            }
+        }
+    }
+    for(unsigned i = 0; i < m_chunks.size(); i++)
+    {
+        m_chunks[i].bricks.reserve(bricks[i]);
+        m_chunks[i].bush_tiles.reserve(bushes[i]);
+        m_chunks[i].obstacles.reserve(obstacles[i]);
+    }
+
+    for(int j = 0; j < rows; j++)
+    {
+        for(int i = 0; i < columns; i++)
+        {
+            Object* tile = nullptr;
+            switch(m_data.tile(j, i))
+            {
+            case LT_BRICK: tile = setTile(j, i, ST_BRICK_WALL); break;
+            case LT_STONE: tile = setTile(j, i, ST_STONE_WALL); break;
+            case LT_WATER: setTile(j, i, ST_WATER); break;
+            case LT_ICE: tile = setTile(j, i, ST_ICE); break;
+            case LT_BUSH:
+            {
+                MapChunk& chunk = m_chunks[j / chunk_size * m_chunk_columns + i / chunk_size];
+                chunk.bush_tiles.push_back(Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_BUSH));
+                chunk.bushes.push_back(&chunk.bush_tiles.back());
+                break;
+            }
+            default: break;
+            }
+            // water is animated and drawn separately, so it is not a part of the terrain
+            if(tile == nullptr) continue;
+            TerrainChunk& terrain = m_terrain[j / terrain_size * terrain_columns + i / terrain_size];
+            terrain.tiles[j % terrain_size * terrain_size + i % terrain_size] = tile->src_rect;
+            terrain.filled++;
+        }
+    }
+
+    // the routes toward the eagle are derived from the map like the terrain, so a map prefetched on a worker thread brings them along
+    m_eagle_flow.build(*this, m_data.eagle());
+    return loaded;
+}
+
+int LevelMap::number() const
+{
+    return m_number;
+}
+
+int LevelMap::rows() const
+{
+    return m_data.height();
+}
+
+int LevelMap::columns() const
+{
+    return m_data.width();
+}
+
+int LevelMap::width() const
+{
+    return m_data.width() * AppConfig::tile_rect.w;
+}
+
+int LevelMap::height() const
+{
+    return m_data.height() * AppConfig::tile_rect.h;
+}
+
+Object *LevelMap::setTile(int row, int column, SpriteType type)
+{
+    MapChunk& chunk = m_chunks.at(row / chunk_size * m_chunk_columns + column / chunk_size);
+    if(chunk.cells.empty())
+    {
+        if(type == ST_NONE) return nullptr;
+        chunk.cells.assign(chunk_size * chunk_size, nullptr);
+    }
+
+    Object*& cell = chunk.cells[row % chunk_size * chunk_size + column % chunk_size];
+    if(cell != nullptr) releaseSlot(chunk, cell);
+    cell = nullptr;
+
+    // bullets are stopped only by walls
+    Uint64& row_word = m_row_walls[row * m_row_words + column / 64];
+    Uint64& column_word = m_column_walls[column * m_column_words + row / 64];
+    if(type == ST_BRICK_WALL || type == ST_STONE_WALL)
+    {
+        row_word |= Uint64(1) << (column % 64);
+        column_word |= Uint64(1) << (row % 64);
+    }
+    else
+    {
+        row_word &= ~(Uint64(1) << (column % 64));
+        column_word &= ~(Uint64(1) << (row % 64));
+    }
+
+    int x = column * AppConfig::tile_rect.w, y = row * AppConfig::tile_rect.h;
+    if(type == ST_BRICK_WALL)
+        cell = place(chunk.bricks, chunk.free_bricks, chunk.cells, true, Brick(x, y));
+    else if(type != ST_NONE)
+    {
+        cell = place(chunk.obstacles, chunk.free_obstacles, chunk.cells, false, Object(x, y, type));
+        if(type == ST_WATER && std::none_of(chunk.water.begin(), chunk.water.end(), [row, column](const SDL_Point& p){return p.x == column && p.y == row;}))
+            chunk.water.push_back({column, row});
+    }
+    return cell;
+}
+
+SDL_Rect LevelMap::chunksIn(const SDL_Rect &area) const
+{
+    int chunk_w = chunk_size * AppConfig::tile_rect.w, chunk_h = chunk_size * AppConfig::tile_rect.h;
+    int x1 = std::max(area.x, 0), y1 = std::max(area.y, 0);
+    int x2 = std::min(area.x + area.w, width()), y2 = std::min(area.y + area.h, height());
+    if(x1 >= x2 || y1 >= y2) return {0, 0, 0, 0};
+
+    SDL_Rect range;
+    range.x = x1 / chunk_w;
+    range.y = y1 / chunk_h;
+    range.w = (x2 - 1) / chunk_w - range.x + 1;
+    range.h = (y2 - 1) / chunk_h - range.y + 1;
+    return range;
+}
+
+MapChunk &LevelMap::chunk(int chunk_row, int chunk_column)
+{
+    return m_chunks[chunk_row * m_chunk_columns + chunk_column];
+}
+
+int LevelMap::bulletRange(int row, int column, Direction direction) const
+{
+    bool vertical = direction == D_UP || direction == D_DOWN;
+    int line = vertical ? column : row, start = vertical ? row : column;
+    int length = vertical ? rows() : columns();
+    if(line < 0 || line >= (vertical ? columns() : rows())) return 0;
+    if(start < 0 || start >= length) return 0;
+
+    const Uint64* words = vertical ? &m_column_walls[line * m_column_words] : &m_row_walls[line * m_row_words];
+    if(direction == D_DOWN || direction == D_RIGHT)
+    {
+        // the lowest set bit at or after the start
+        int w = start / 64;
+        Uint64 bits = words[w] & (~Uint64(0) << (start % 64));
+        int word_count = vertical ? m_column_words : m_row_words;
+        while(bits == 0 && ++w < word_count) bits = words[w];
+        int wall = bits == 0 ? length : w * 64 + __builtin_ctzll(bits);
+        return std::min(wall, length) - start;
+    }
+
+    // the highest set bit at or before the start
+    int w = start / 64;
+    Uint64 bits = words[w] & (~Uint64(0) >> (63 - start % 64));
+    while(bits == 0 && --w >= 0) bits = words[w];
+    int wall = bits == 0 ? -1 : w * 64 + 63 - __builtin_clzll(bits);
+    return start - wall;
+}
+
+std::vector<TerrainChunk> &LevelMap::terrainChunks()
+{
+    return m_terrain;
+}
+
+const LevelData &LevelMap::data() const
+{
+    return m_data;
+}
+
+FlowField &LevelMap::eagleFlow()
+{
+    return m_eagle_flow;
+}
+
+template<typename T>
+T* LevelMap::place(std::vector<T> &pool, std::vector<Uint16> &free_slots, std::vector<Object *> &cells, bool brick, const T &object)
+{
+    if(!free_slots.empty())
+    {
+        T* slot = &pool[free_slots.back()];
+        free_slots.pop_back();
+        *slot = object;
+        return slot;
+    }
+
+    if(pool.size() < pool.capacity() || pool.empty())
+    {
+        pool.push_back(object);
+        return &pool.back();
+    }
+
+    // growing moves the objects, so the cells of the pool are pointed at them again by their slot indexes
+    std::vector<int> slots(cells.size(), -1);
+    for(unsigned i = 0; i < cells.size(); i++)
+        if(cells[i] != nullptr && (cells[i]->type == ST_BRICK_WALL) == brick)
+            slots[i] = static_cast<T*>(cells[i]) - pool.data();
+
+    pool.push_back(object);
+    for(unsigned i = 0; i < cells.size(); i++)
+        if(slots[i] >= 0) cells[i] = &pool[slots[i]];
+    return &pool.back();
+}
+
+void LevelMap::releaseSlot(MapChunk &chunk, Object *object)
+{
+    if(object->type == ST_BRICK_WALL)
+        chunk.free_bricks.push_back(static_cast<Brick*>(object) - chunk.bricks.data());
+    else
+        chunk.free_obstacles.push_back(object - chunk.obstacles.data());
+}
@@ -0,0 +1,216 @@
+#ifndef LEVELMAP_H
+#define LEVELMAP_H
+
+#include "flowfield.h"
+#include "leveldata.h"
+#include "../engine/rendercommandbuffer.h"
+#include "../objects/object.h"
+#include "../objects/brick.h"
+#include <vector>
+
+/**
+ * @brief
+ * Square block of @a LevelMap::chunk_size x @a LevelMap::chunk_size cells of a map with its own pools of map objects.
+ * Storage of a chunk is allocated only if the chunk contains anything, so large maps with empty areas stay small.
+ */
+struct MapChunk
+{
+    /**
+     * Obstacles of the cells in row order; empty if the chunk has never held an obstacle
+     */
+    std::vector<Object*> cells;
+    /**
+     * Pool of brick walls
+     */
+    std::vector<Brick> bricks;
+    /**
+     * Indexes of unused slots of @a bricks
+     */
+    std::vector<Uint16> free_bricks;
+    /**
+     * Pool of the other obstacles (stone, water, ice)
+     */
+    std::vector<Object> obstacles;
+    /**
+     * Indexes of unused slots of @a obstacles
+     */
+    std::vector<Uint16> free_obstacles;
+    /**
+     * Pool of bushes; bushes are only created when the map is loaded
+     */
+    std::vector<Object> bush_tiles;
+    /**
+     * Bushes of the chunk
+     */
+    std::vector<Object*> bushes;
+    /**
+     * Cells with water (x - column, y - row)
+     */
+    std::vector<SDL_Point> water;
+};
+
+/**
+ * @brief
+ * Class holds the map of a level: the grid of obstacles, bushes and water cells together with the level data they were built from.
+ * The grid is divided into chunks (@a MapChunk), so drawing and collision checks visit only the chunks around the place they concern
+ * and their cost does not grow with the size of the map. Map objects live in pools of their chunk, so building and changing the map
+ * allocates no objects per tile.
+ * Loading touches only the level files, the level pack and the sprite configuration, so a map can be built on a worker thread.
+ */
+class LevelMap
+{
+public:
+    /**
+     * Number of rows and columns of a chunk
+     */
+    static const int chunk_size = 16;
+
+    LevelMap();
+
+    /**
+     * Loading a level and building its map. The level is taken from the resident level pack; if the pack does not contain it,
+     * the compiled level N.lvl and then the text file N from @a AppConfig::levels_path are used. Levels found nowhere are generated
+     * by @a LevelGenerator if @a AppConfig::endless_levels is set.
+     * @param number - number of the level
+     * @return @a false if the level could not be loaded; the map is empty then
+     */
+    bool load(int number);
+    /**
+     * @return number of the loaded level
+     */
+    int number() const;
+    /**
+     * @return number of rows of the grid
+     */
+    int rows() const;
+    /**
+     * @return number of columns of the grid
+     */
+    int columns() const;
+    /**
+     * @return width of the map in pixels
+     */
+    int width() const;
+    /**
+     * @return height of the map in pixels
+     */
+    int height() const;
+    /**
+     * @param row - row of the cell, has to be inside the grid
+     * @param column - column of the cell, has to be inside the grid
+     * @return obstacle in the cell or @a nullptr
+     */
+    inline Object* tile(int row, int column) const;
+    /**
+     * Placing a new object of the given type in the cell; the slot of the previous object is reused by later changes.
+     * A new water cell is added to the water cells of its chunk.
+     * @param row - row of the cell
+     * @param column - column of the cell
+     * @param type - type of the new object; @a ST_NONE empties the cell
+     * @return new object of the cell or @a nullptr
+     */
+    Object* setTile(int row, int column, SpriteType type);
+    /**
+     * Finding the chunks covering an area of the map
+     * @param area - rectangle in pixels
+     * @return range of chunks (x - first chunk column, y - first chunk row, w and h - numbers of chunks) clipped to the map; empty if the area is outside the map
+     */
+    SDL_Rect chunksIn(const SDL_Rect& area) const;
+    /**
+     * @param chunk_row - row of the chunk
+     * @param chunk_column - column of the chunk
+     * @return chunk; has to be inside the map
+     */
+    MapChunk& chunk(int chunk_row, int chunk_column);
+    /**
+     * Finding the first cell stopping bullets (brick or stone wall) on a straight line; rows and columns are kept as bitmasks,
+     * so the scan tests 64 cells at once
+     * @param row - row of the first checked cell
+     * @param column - column of the first checked cell
+     * @param direction - direction of the line
+     * @return number of cells from the first checked cell to the stopping cell; if no cell stops bullets, the distance to the first cell outside the map
+     */
+    int bulletRange(int row, int column, Direction direction) const;
+    /**
+     * @return chunks of the terrain cache of the renderer prepared for the loaded map, which @a Renderer::setTerrain takes over;
+     * water and empty cells have zero width
+     */
+    std::vector<TerrainChunk>& terrainChunks();
+    /**
+     * @return data of the level
+     */
+    const LevelData& data() const;
+    /**
+     * Routes of enemies toward the eagle over the whole level, built by @a load; whoever changes cells of the map repairs them
+     * @return flow field toward the eagle
+     */
+    FlowField& eagleFlow();
+
+private:
+    /**
+     * Placing an object in a free slot of a pool of the chunk; when the pool has to grow, the cells pointing into it are moved to the new storage
+     * @param pool - pool of the chunk
+     * @param free_slots - unused slots of the pool
+     * @param cells - cells of the chunk
+     * @param brick - @a true for the pool of brick walls, @a false for the pool of the other obstacles
+     * @param object - placed object
+     * @return object in the pool
+     */
+    template<typename T>
+    static T* place(std::vector<T>& pool, std::vector<Uint16>& free_slots, std::vector<Object*>& cells, bool brick, const T& object);
+    /**
+     * Returning the slot of an obstacle to the pool it belongs to
+     * @param chunk - chunk of the obstacle
+     * @param object - obstacle of a cell of the chunk
+     */
+    static void releaseSlot(MapChunk& chunk, Object* object);
+
+    /**
+     * Number of the level
+     */
+    int m_number;
+    /**
+     * Data of the level
+     */
+    LevelData m_data;
+    /**
+     * Number of chunk columns
+     */
+    int m_chunk_columns;
+    /**
+     * Chunks in row order
+     */
+    std::vector<MapChunk> m_chunks;
+    /**
+     * Terrain chunks of the loaded map in row order, filled on the thread loading the map
+     */
+    std::vector<TerrainChunk> m_terrain;
+    /**
+     * Number of 64-bit words of a row of @a m_row_walls
+     */
+    int m_row_words;
+    /**
+     * Number of 64-bit words of a column of @a m_column_walls
+     */
+    int m_column_words;
+    /**
+     * Cells stopping bullets, row by row; bit i of word w of a row is the column 64 * w + i
+     */
+    std::vector<Uint64> m_row_walls;
+    /**
+     * The same cells column by column; bit i of word w of a column is the row 64 * w + i
+     */
+    std::vector<Uint64> m_column_walls;
+    /**
+     * Routes toward the eagle
+     */
+    FlowField m_eagle_flow;
+};
+
+inline Object* LevelMap::tile(int row, int column) const
+{
+    const MapChunk& chunk = m_chunks[row / chunk_size * m_chunk_columns + column / chunk_size];
+    return chunk.cells.empty() ? nullptr : chunk.cells[row % chunk_size * chunk_size + column % chunk_size];
+}
+
+#endif // LEVELMAP_H
@@ -0,0 +1,100 @@
+#include "levelpack.h"
+#include <cstdio>
+#include <cstring>
+
+static const char pack_magic[4] = {'T', 'N', 'K', 'P'};
+static const Uint32 pack_version = 2;
+/**
+ * Size of the header of a pack in bytes
+ */
+static const size_t header_size = 12;
+
+static void writeValue(FILE* file, Uint32 value, int size)
+{
+    Uint8 bytes[4];
+    for(int i = 0; i < size; i++)
+        bytes[i] = value >> (8 * i);
+    fwrite(bytes, 1, size, file);
+}
+
+static Uint32 readValue(const Uint8* data, int size)
+{
+    Uint32 value = 0;
+    for(int i = 0; i < size; i++)
+        value |= static_cast<Uint32>(data[i]) << (8 * i);
+    return value;
+}
+
+LevelPack::LevelPack()
+{
+    m_count = 0;
+}
+
+bool LevelPack::write(const std::string &path, const std::vector< std::vector<Uint8> > &levels)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if(file == nullptr) return false;
+
+    fwrite(pack_magic, 1, sizeof(pack_magic), file);
+    writeValue(file, pack_version, 4);
+    writeValue(file, levels.size(), 4);
+
+    Uint32 offset = header_size + 8 * levels.size();
+    for(const std::vector<Uint8>& level : levels)
+    {
+        writeValue(file, offset, 4);
+        writeValue(file, level.size(), 4);
+        offset += level.size();
+    }
+    for(const std::vector<Uint8>& level : levels)
+        fwrite(level.data(), 1, level.size(), file);
+
+    bool written = !ferror(file);
+    return fclose(file) == 0 && written;
+}
+
+bool LevelPack::open(const std::string &path)
+{
+    m_count = 0;
+    if(!m_file.open(path)) return false;
+
+    const Uint8* data = m_file.data();
+    size_t size = m_file.size();
+    if(size < header_size || memcmp(data, pack_magic, sizeof(pack_magic)) != 0 || readValue(data + 4, 4) != pack_version)
+    {
+        m_file.close();
+        return false;
+    }
+
+    Uint32 count = readValue(data + 8, 4);
+    if(count == 0 || count > (size - header_size) / 8)
+    {
+        m_file.close();
+        return false;
+    }
+    for(Uint32 i = 0; i < count; i++)
+    {
+        const Uint8* entry = data + header_size + 8 * i;
+        Uint32 offset = readValue(entry, 4), length = readValue(entry + 4, 4);
+        if(offset > size || length > size - offset)
+        {
+            m_file.close();
+            return false;
+        }
+    }
+    m_count = count;
+    return true;
+}
+
+int LevelPack::count() const
+{
+    return m_count;
+}
+
+bool LevelPack::level(int number, LevelData &data) const
+{
+    if(number < 1 || number > m_count) return false;
+
+    const Uint8* entry = m_file.data() + header_size + 8 * (number - 1);
+    return data.attach(m_file.data() + readValue(entry, 4), readValue(entry + 4, 4));
+}
@@ -0,0 +1,58 @@
+#ifndef LEVELPACK_H
+#define LEVELPACK_H
+
+#include "leveldata.h"
+#include "mappedfile.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Class gives access to a pack of compiled levels kept in one file. The file is mapped once and stays resident, so switching levels
+ * is a lookup in the index and no file is opened again.
+ *
+ * Format (little-endian): header "TNKP", version, number of levels (4 bytes each); the index with the offset from the start of the file
+ * and the size of every level (4 bytes each); then the levels in the compiled format of @a LevelData. The first level of the index is the stage 1, and a pack holds at least one level.
+ */
+class LevelPack
+{
+public:
+    LevelPack();
+
+    /**
+     * Writing a pack
+     * @param path - path of the file
+     * @param levels - compiled levels in the order of stages
+     * @return @a false if the file could not be written
+     */
+    static bool write(const std::string& path, const std::vector< std::vector<Uint8> >& levels);
+    /**
+     * Mapping a pack; the previously opened pack is closed
+     * @param path - path of the file
+     * @return @a false if the file could not be mapped, holds no level or its index does not fit in the file
+     */
+    bool open(const std::string& path);
+    /**
+     * @return number of levels in the pack, which is also the number of its last stage; 0 if no pack is opened
+     */
+    int count() const;
+    /**
+     * Pointing the level data to a level of the pack
+     * @param number - number of the stage, from 1
+     * @param data - level data that will use the memory of the pack
+     * @return @a false if there is no such level or it is not valid
+     */
+    bool level(int number, LevelData& data) const;
+
+private:
+    /**
+     * Mapped pack
+     */
+    MappedFile m_file;
+    /**
+     * Number of levels
+     */
+    int m_count;
+};
+
+#endif // LEVELPACK_H
@@ -0,0 +1,61 @@
+#include "levelprefetcher.h"
+#include "levelmap.h"
+
+LevelPrefetcher::LevelPrefetcher()
+{
+    m_thread = nullptr;
+    m_number = 0;
+    m_map = nullptr;
+    m_loaded = false;
+}
+
+LevelPrefetcher::~LevelPrefetcher()
+{
+    wait();
+    delete m_map;
+}
+
+void LevelPrefetcher::prefetch(int number)
+{
+    wait();
+    delete m_map;
+
+    m_number = number;
+    m_map = new LevelMap;
+    m_loaded = false;
+    m_thread = SDL_CreateThread(prefetchThread, "level prefetch", this);
+    if(m_thread == nullptr)
+    {
+        delete m_map;
+        m_map = nullptr;
+    }
+}
+
+LevelMap *LevelPrefetcher::take(int number)
+{
+    // joining the worker makes everything it wrote visible to this thread
+    wait();
+
+    LevelMap* map = m_map;
+    m_map = nullptr;
+    if(map != nullptr && (m_number != number || !m_loaded))
+    {
+        delete map;
+        map = nullptr;
+    }
+    return map;
+}
+
+int LevelPrefetcher::prefetchThread(void *prefetcher)
+{
+    LevelPrefetcher* self = static_cast<LevelPrefetcher*>(prefetcher);
+    self->m_loaded = self->m_map->load(self->m_number);
+    return 0;
+}
+
+void LevelPrefetcher::wait()
+{
+    if(m_thread == nullptr) return;
+    SDL_WaitThread(m_thread, nullptr);
+    m_thread = nullptr;
+}
@@ -0,0 +1,64 @@
+#ifndef LEVELPREFETCHER_H
+#define LEVELPREFETCHER_H
+
+#include <SDL2/SDL.h>
+
+class LevelMap;
+
+/**
+ * @brief
+ * Class builds the map of a level on a worker thread while another screen is shown, e.g. the score screen before the next stage.
+ * The finished map is handed over with @a take, so the next @a Game starts without loading.
+ */
+class LevelPrefetcher
+{
+public:
+    LevelPrefetcher();
+    /**
+     * Waiting for the worker and dropping a map that was not taken
+     */
+    ~LevelPrefetcher();
+
+    /**
+     * Starting to build the map of a level in the background; a map prepared earlier and not taken is dropped
+     * @param number - number of the level
+     */
+    void prefetch(int number);
+    /**
+     * Taking over the prepared map. If the worker has not finished yet, the function waits for it.
+     * @param number - number of the wanted level
+     * @return map of the level owned by the caller, or @a nullptr if that level was not prefetched or could not be loaded
+     */
+    LevelMap* take(int number);
+
+private:
+    /**
+     * Function of the worker thread
+     * @param prefetcher - pointer to the @a LevelPrefetcher object
+     * @return 0
+     */
+    static int prefetchThread(void* prefetcher);
+    /**
+     * Waiting for the worker thread to finish
+     */
+    void wait();
+
+    /**
+     * Worker thread or @a nullptr if no level is being built
+     */
+    SDL_Thread* m_thread;
+    /**
+     * Number of the prefetched level
+     */
+    int m_number;
+    /**
+     * Prepared map; written by the worker, read after the worker has finished
+     */
+    LevelMap* m_map;
+    /**
+     * Result of loading the prepared map
+     */
+    bool m_loaded;
+};
+
+#endif // LEVELPREFETCHER_H
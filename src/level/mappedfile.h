@@ -0,0 +1,57 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+
+/**
+ * @brief
+ * Read-only view of a whole file mapped into memory. Pages are read by the system when they are touched, so opening a file costs
+ * no copying; the view is valid until @a close or the destruction of the object.
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**
+     * Mapping a file; the previously mapped file is closed
+     * @param path - path of the file
+     * @return @a false if the file could not be opened or is empty
+     */
+    bool open(const std::string& path);
+    /**
+     * Unmapping the file
+     */
+    void close();
+    /**
+     * @return first byte of the file or @a nullptr if no file is mapped
+     */
+    const Uint8* data() const;
+    /**
+     * @return size of the file in bytes
+     */
+    size_t size() const;
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    /**
+     * Mapped bytes
+     */
+    const Uint8* m_data;
+    /**
+     * Size of the mapping
+     */
+    size_t m_size;
+#ifdef _WIN32
+    /**
+     * File mapping object
+     */
+    void* m_mapping;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -8,11 +8,37 @@
 */
 
 #include "app.h"
+#include "appconfig.h"
+
+#include <cstdlib>
+#include <string>
 
 int main( int argc, char* args[] )
 {
-    App app;
-    app.run();
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg = args[i];
+        if(arg == "--benchmark") AppConfig::benchmark = true;
+        else if(arg == "--capture" && i + 1 < argc) AppConfig::capture_path = args[++i];
+        else if(arg == "--capture-format" && i + 1 < argc) AppConfig::capture_format = args[++i];
+        else if(arg == "--frame-time" && i + 1 < argc) AppConfig::present_frame_time = atof(args[++i]);
+        else if(arg == "--pacing-stats") AppConfig::show_pacing_stats = true;
+        else if(arg == "--record" && i + 1 < argc) AppConfig::record_path = args[++i];
+        else if(arg == "--replay" && i + 1 < argc) AppConfig::replay_path = args[++i];
+        else if(arg == "--headless") AppConfig::headless = true;
+        else if(arg == "--golden" && i + 1 < argc) AppConfig::golden_path = args[++i];
+        else if(arg == "--update-golden") AppConfig::update_golden = true;
+        else if(arg == "--golden-images" && i + 1 < argc) AppConfig::golden_images_path = args[++i];
+        else if(arg == "--diff-dir" && i + 1 < argc) AppConfig::diff_path = args[++i];
+        else if(arg == "--frame-step" && i + 1 < argc) AppConfig::verify_frame_step = atoi(args[++i]);
+        else if(arg == "--pack" && i + 1 < argc) AppConfig::level_pack_path = args[++i];
+        else if(arg == "--endless") AppConfig::endless_levels = true;
+        else if(arg == "--enemies" && i + 1 < argc) AppConfig::enemy_max_count_on_map = atoi(args[++i]);
+        else if(arg == "--ai-interval" && i + 1 < argc) AppConfig::ai_think_interval = atoi(args[++i]);
+        else if(arg == "--ai-budget" && i + 1 < argc) AppConfig::ai_budget = atoi(args[++i]);
+        else if(arg == "--ai-threads" && i + 1 < argc) AppConfig::ai_threads = atoi(args[++i]);
+    }
 
-    return 0;
+    App app;
+    return app.run();
 }
@@ -8,7 +8,7 @@ Bonus::Bonus()
     m_show = true;
 }
 
-Bonus::Bonus(double x, double y, SpriteType type)
+Bonus::Bonus(int x, int y, SpriteType type)
     : Object(x, y, type)
 {
     m_bonus_show_time = 0;
@@ -6,7 +6,7 @@
 /**
  * @brief Class responsible for displaying the bonus
  */
-class Bonus : public Object
+class Bonus final : public Object
 {
 public:
     /**
@@ -19,7 +19,7 @@ public:
      * @param y - Initial vertical position
      * @param type - Type of bonus
      */
-    Bonus(double x, double y, SpriteType type);
+    Bonus(int x, int y, SpriteType type);
 
     /**
      * Function for drawing the bonus
@@ -8,7 +8,7 @@ Brick::Brick()
     m_state_code = 0;
 }
 
-Brick::Brick(double x, double y)
+Brick::Brick(int x, int y)
     : Object(x, y, ST_BRICK_WALL)
 {
     m_collision_count = 0;
@@ -33,7 +33,7 @@ void Brick::bulletHit(Direction bullet_direction)
         int sum_square = (m_state_code - 1) * (m_state_code - 1) + bd * bd;
         if(sum_square % 2 == 1)
         {
-            m_state_code = ((double)sum_square + 19.0) / 4.0;
+            m_state_code = (sum_square + 19) / 4;
         }
         else
         {
@@ -47,53 +47,54 @@ void Brick::bulletHit(Direction bullet_direction)
         to_erase = true;
     }
 
+    int x = fixedToInt(pos_x), y = fixedToInt(pos_y);
     switch(m_state_code)
     {
     case 1:
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y;
+        collision_rect.x = x;
+        collision_rect.y = y;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w;
         break;
     case 2:
-        collision_rect.x = pos_x + m_sprite->rect.w / 2;
-        collision_rect.y = pos_y;
+        collision_rect.x = x + m_sprite->rect.w / 2;
+        collision_rect.y = y;
         collision_rect.h = m_sprite->rect.h;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 3:
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y +  m_sprite->rect.h / 2;
+        collision_rect.x = x;
+        collision_rect.y = y +  m_sprite->rect.h / 2;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w;
         break;
     case 4:
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y;
+        collision_rect.x = x;
+        collision_rect.y = y;
         collision_rect.h = m_sprite->rect.h;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 5:
-        collision_rect.x = pos_x + m_sprite->rect.w / 2;
-        collision_rect.y = pos_y;
+        collision_rect.x = x + m_sprite->rect.w / 2;
+        collision_rect.y = y;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 6:
-        collision_rect.x = pos_x + m_sprite->rect.w / 2;
-        collision_rect.y = pos_y + m_sprite->rect.h / 2;
+        collision_rect.x = x + m_sprite->rect.w / 2;
+        collision_rect.y = y + m_sprite->rect.h / 2;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 7:
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y;
+        collision_rect.x = x;
+        collision_rect.y = y;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 8:
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y + m_sprite->rect.h / 2;
+        collision_rect.x = x;
+        collision_rect.y = y + m_sprite->rect.h / 2;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
@@ -105,5 +106,10 @@ void Brick::bulletHit(Direction bullet_direction)
         break;
     }
 
-    src_rect = moveRect(m_sprite->rect, 0, m_state_code);
+    src_rect = m_frames[m_state_code];
+}
+
+bool Brick::isIntact() const
+{
+    return m_collision_count == 0;
 }
@@ -6,7 +6,7 @@
 /**
  * @brief Class responsible for a single piece of the wall
  */
-class Brick : public Object
+class Brick final : public Object
 {
 public:
     /**
@@ -18,7 +18,7 @@ public:
      * @param x - Initial horizontal position
      * @param y - Initial vertical position
      */
-    Brick(double x, double y);
+    Brick(int x, int y);
 
     /**
      * The function was implemented to avoid modifying collision_rect
@@ -30,6 +30,11 @@ public:
      * @param bullet_direction - direction of the bullet's movement
      */
     void bulletHit(Direction bullet_direction);
+    /**
+     * Checking whether the wall has not been hit by any bullet yet
+     * @return @a true if the wall is intact, otherwise @a false
+     */
+    bool isIntact() const;
 private:
     /**
      * Number of bullet hits on the wall
@@ -4,16 +4,16 @@
 Bullet::Bullet()
     : Object(0, 0, ST_BULLET)
 {
-    speed = 0.0;
+    speed = 0;
     direction = D_UP;
     increased_damage = false;
     collide = false;
 }
 
-Bullet::Bullet(double x, double y)
+Bullet::Bullet(int x, int y)
     : Object(x, y, ST_BULLET)
 {
-    speed = 0.0;
+    speed = 0;
     direction = D_UP;
     increased_damage = false;
     collide = false;
@@ -23,23 +23,25 @@ void Bullet::update(Uint32 dt)
 {
     if(!collide)
     {
+        Fixed distance = speed * static_cast<Fixed>(dt);
         switch (direction)
         {
         case D_UP:
-            pos_y -= speed * dt;
+            pos_y -= distance;
             break;
         case D_RIGHT:
-            pos_x += speed * dt;
+            pos_x += distance;
             break;
         case D_DOWN:
-            pos_y += speed * dt;
+            pos_y += distance;
             break;
         case D_LEFT:
-            pos_x -= speed * dt;
+            pos_x -= distance;
             break;
         }
 
-        src_rect = moveRect(m_sprite->rect, direction, 0);
+        setVariant(direction);
+        src_rect = m_frames[0];
         Object::update(dt);
     }
     else
@@ -53,8 +55,8 @@ void Bullet::update(Uint32 dt)
                 m_current_frame++;
                 if(m_current_frame >= m_sprite->frames_count)
                     to_erase = true;
-
-                src_rect = moveRect(m_sprite->rect, 0, m_current_frame);
+                else
+                    src_rect = m_frames[m_current_frame];
             }
         }
     }
@@ -68,34 +70,31 @@ void Bullet::destroy()
     speed = 0;
     m_current_frame = 0;
     m_frame_display_time = 0;
-    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_BULLET);
+    setSprite(Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_BULLET));
 
+    int x = fixedToInt(pos_x), y = fixedToInt(pos_y);
     switch(direction)
     {
     case D_UP:
-        dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w) / 2; // dest_rect.w, dest_rect.h - old size of the projectile
-        dest_rect.y = pos_y - m_sprite->rect.h / 2;
+        dest_rect.x = x + (dest_rect.w - m_sprite->rect.w) / 2; // dest_rect.w, dest_rect.h - old size of the projectile
+        dest_rect.y = y - m_sprite->rect.h / 2;
         break;
     case D_RIGHT:
-        dest_rect.x = pos_x + dest_rect.w - m_sprite->rect.w / 2;
-        dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h) / 2;
+        dest_rect.x = x + dest_rect.w - m_sprite->rect.w / 2;
+        dest_rect.y = y + (dest_rect.h - m_sprite->rect.h) / 2;
         break;
     case D_DOWN:
-        dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w) / 2;
-        dest_rect.y = pos_y + dest_rect.h - m_sprite->rect.h / 2;
+        dest_rect.x = x + (dest_rect.w - m_sprite->rect.w) / 2;
+        dest_rect.y = y + dest_rect.h - m_sprite->rect.h / 2;
         break;
     case D_LEFT:
-        dest_rect.x = pos_x - m_sprite->rect.w / 2;
-        dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h) / 2;
+        dest_rect.x = x - m_sprite->rect.w / 2;
+        dest_rect.y = y + (dest_rect.h - m_sprite->rect.h) / 2;
         break;
     }
 
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
-    src_rect.x = m_sprite->rect.x;
-    src_rect.y = m_sprite->rect.y;
-    src_rect.h = m_sprite->rect.h;
-    src_rect.w = m_sprite->rect.w;
-
+    src_rect = m_frames[0];
 }
@@ -6,7 +6,7 @@
 /**
  * @brief Class responsible for projectiles fired by tanks
  */
-class Bullet : public Object
+class Bullet final : public Object
 {
 public:
     /**
@@ -18,7 +18,7 @@ public:
      * @param x - initial horizontal position
      * @param y - initial vertical position
      */
-    Bullet(double x, double y);
+    Bullet(int x, int y);
 
     /**
      * Updating the position of the projectile
@@ -31,9 +31,9 @@ public:
     void destroy();
     
     /**
-     * The speed of the projectile's movement
+     * The speed of the projectile's movement in pixels per millisecond, in the @a Fixed format
      */
-    double speed;
+    Fixed speed;
     /**
      * The variable stores information about whether the projectile has collided with something
      */
@@ -6,7 +6,7 @@
 /**
  * @brief The class of the eagle that players are to defend and opponents to destroy
  */
-class Eagle : public Object
+class Eagle final : public Object
 {
 public:
     /**
@@ -18,7 +18,7 @@ public:
      * @param x - initial horizontal position
      * @param y - initial vertical position
      */
-    Eagle(double x, double y);
+    Eagle(int x, int y);
     /**
      * Updating the eagle animation
      * @param dt - time since the last function call
@@ -1,5 +1,8 @@
 #include "enemy.h"
 #include "../appconfig.h"
+#include "../level/flowfield.h"
+#include "../level/levelmap.h"
+#include <climits>
 #include <stdlib.h>
 #include <ctime>
 #include <iostream>
@@ -23,16 +26,21 @@ Enemy::Enemy()
     m_frozen_time = 0;
 
     if(type == ST_TANK_B)
-        default_speed = AppConfig::tank_default_speed * 1.3;
+        default_speed = AppConfig::tank_default_speed * 13 / 10;
     else
         default_speed = AppConfig::tank_default_speed;
 
     target_position = {-1, -1};
+    flow_field = nullptr;
+    m_follow_flow = false;
+    m_blocked = false;
+    m_random = (static_cast<Uint32>(rand()) * 2654435761u) | 1;
+    m_intent.targeted = false;
 
     respawn();
 }
 
-Enemy::Enemy(double x, double y, SpriteType type)
+Enemy::Enemy(int x, int y, SpriteType type)
     : Tank(x, y, type)
 {
     direction = D_DOWN;
@@ -51,11 +59,16 @@ Enemy::Enemy(double x, double y, SpriteType type)
     m_frozen_time = 0;
 
     if(type == ST_TANK_B)
-        default_speed = AppConfig::tank_default_speed * 1.3;
+        default_speed = AppConfig::tank_default_speed * 13 / 10;
     else
         default_speed = AppConfig::tank_default_speed;
 
     target_position = {-1, -1};
+    flow_field = nullptr;
+    m_follow_flow = false;
+    m_blocked = false;
+    m_random = (static_cast<Uint32>(rand()) * 2654435761u) | 1;
+    m_intent.targeted = false;
 
     respawn();
 }
@@ -83,89 +96,231 @@ void Enemy::update(Uint32 dt)
     if(to_erase) return;
     Tank::update(dt);
 
+    // tanks carrying a bonus are drawn with the 4 variants preceding the armour levels
     if(testFlag(TSF_LIFE))
-    {
-        if(testFlag(TSF_BONUS))
-            src_rect = moveRect(m_sprite->rect, (testFlag(TSF_ON_ICE) ? new_direction : direction) - 4, m_current_frame);
-        else
-            src_rect = moveRect(m_sprite->rect, (testFlag(TSF_ON_ICE) ? new_direction : direction) + (lives_count -1) * 4, m_current_frame);
-    }
-    else
-        src_rect = moveRect(m_sprite->rect, 0, m_current_frame);
+        setVariant((testFlag(TSF_ON_ICE) ? new_direction : direction) + (testFlag(TSF_BONUS) ? -4 : (lives_count - 1) * 4));
+    src_rect = m_frames[m_current_frame];
 
     if(testFlag(TSF_FROZEN)) return;
 
     m_direction_time += dt;
     m_speed_time += dt;
     m_fire_time += dt;
+    if(m_follow_flow && flow_field != nullptr) followFlow();
+    if(m_speed_time > m_try_to_go_time)
+    {
+        m_speed_time = 0;
+        m_try_to_go_time = random() % 300;
+        speed = default_speed;
+    }
+
+    // a collision is remembered until the next decision, which may come a few ticks later
+    if(stop) m_blocked = true;
+    stop = false;
+}
+
+void Enemy::think(const WorldSnapshot &world)
+{
+    m_intent.targeted = false;
+    if(to_erase) return;
+    chooseTarget(world);
+
+    m_intent.decided = !testFlag(TSF_FROZEN);
+    m_intent.turn = false;
+    m_intent.reload = false;
+    if(!m_intent.decided) return;
+
+    SDL_Point target = m_intent.target;
+    Direction heading = direction;
     if(m_direction_time > m_keep_direction_time)
     {
-        m_direction_time = 0;
-        m_keep_direction_time = rand() % 800 + 100;
+        m_intent.turn = true;
+        m_intent.keep_direction_time = random() % 800 + 100;
 
-        float p = static_cast<float>(rand()) / RAND_MAX;
+        float p = static_cast<float>(random()) / UINT_MAX;
+        Direction flow_direction;
+        SDL_Point position = FlowField::positionOf(dest_rect);
+        m_intent.follow_flow = false;
 
-        if(p < (type == ST_TANK_A ? 0.8 : 0.5) && target_position.x > 0 && target_position.y > 0)
+        if(p < (type == ST_TANK_A ? 0.8 : 0.5) && m_intent.flow != nullptr && m_intent.flow->direction(position.x, position.y, flow_direction))
         {
-            int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
-            int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
+            heading = flow_direction;
+            m_intent.follow_flow = true;
+        }
+        else if(p < (type == ST_TANK_A ? 0.8 : 0.5) && target.x > 0 && target.y > 0)
+        {
+            int dx = target.x - (dest_rect.x + dest_rect.w / 2);
+            int dy = target.y - (dest_rect.y + dest_rect.h / 2);
 
-            p = static_cast<float>(rand()) / RAND_MAX;
+            p = static_cast<float>(random()) / UINT_MAX;
 
             if(abs(dx) > abs(dy))
-                setDirection(p < 0.7 ? (dx < 0 ? D_LEFT : D_RIGHT) : (dy < 0 ? D_UP : D_DOWN));
+                heading = p < 0.7 ? (dx < 0 ? D_LEFT : D_RIGHT) : (dy < 0 ? D_UP : D_DOWN);
             else
-                setDirection(p < 0.7 ? (dy < 0 ? D_UP : D_DOWN) : (dx < 0 ? D_LEFT : D_RIGHT));
+                heading = p < 0.7 ? (dy < 0 ? D_UP : D_DOWN) : (dx < 0 ? D_LEFT : D_RIGHT);
         }
         else
-            setDirection(static_cast<Direction>(rand() % 4));
-    }
-    if(m_speed_time > m_try_to_go_time)
-    {
-        m_speed_time = 0;
-        m_try_to_go_time = rand() % 300;
-        speed = default_speed;
+            heading = static_cast<Direction>(random() % 4);
+        m_intent.direction = heading;
     }
     if(m_fire_time > m_reload_time)
     {
-        m_fire_time = 0;
+        m_intent.reload = true;
+        // D shoots at its target and at walls holding it up; the others fire at anything but stone and the border of the map
         if(type == ST_TANK_D)
         {
-            m_reload_time = rand() % 400;
-            int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
-            int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
-
-            if(stop) fire();
-            else
-                switch (direction)
-                {
-                case D_UP:
-                    if(dy < 0 && abs(dx) < dest_rect.w) fire();
-                    break;
-                case D_RIGHT:
-                    if(dx > 0 && abs(dy) < dest_rect.h) fire();
-                    break;
-                case D_DOWN:
-                    if(dy > 0 && abs(dx) < dest_rect.w) fire();
-                    break;
-                case D_LEFT:
-                    if(dx < 0 && abs(dy) < dest_rect.h) fire();
-                    break;
-                }
+            m_intent.reload_time = random() % 400;
+            ShotOutcome shot = aimShot(world.map, heading, target);
+            m_intent.fire = shot == SO_TARGET || shot == SO_BRICK_BEFORE_TARGET || (m_blocked && shot == SO_BRICK);
         }
         else if(type == ST_TANK_C)
         {
-            m_reload_time = rand() % 800;
-            fire();
+            m_intent.reload_time = random() % 800;
+            m_intent.fire = aimShot(world.map, heading, target) != SO_WASTED;
         }
         else
         {
-            m_reload_time = rand() % 1000;
-            fire();
+            m_intent.reload_time = random() % 1000;
+            m_intent.fire = aimShot(world.map, heading, target) != SO_WASTED;
         }
     }
+}
 
-    stop = false;
+void Enemy::apply()
+{
+    if(!m_intent.targeted) return;
+    target_position = m_intent.target;
+    flow_field = m_intent.flow;
+    if(!m_intent.decided) return;
+
+    if(m_intent.turn)
+    {
+        m_direction_time = 0;
+        m_keep_direction_time = m_intent.keep_direction_time;
+        m_follow_flow = m_intent.follow_flow;
+        setDirection(m_intent.direction);
+    }
+    if(m_intent.reload)
+    {
+        m_fire_time = 0;
+        m_reload_time = m_intent.reload_time;
+        if(m_intent.fire) fire();
+    }
+    m_blocked = false;
+}
+
+int Enemy::chasedPlayer() const
+{
+    return m_intent.targeted ? m_intent.chased : -1;
+}
+
+void Enemy::chooseTarget(const WorldSnapshot &world)
+{
+    int min_metric = INT_MAX;
+    int metric;
+    m_intent.targeted = true;
+    m_intent.chased = -1;
+    m_intent.target = {-1, -1};
+    m_intent.flow = nullptr;
+    if(type == ST_TANK_A || type == ST_TANK_D)
+        for(unsigned i = 0; i < world.players.size(); i++)
+        {
+            const SDL_Rect& player = world.players[i];
+            metric = abs(player.x - dest_rect.x) + abs(player.y - dest_rect.y);
+            if(metric < min_metric)
+            {
+                min_metric = metric;
+                m_intent.chased = i;
+                m_intent.target = {player.x + player.w / 2, player.y + player.h / 2};
+                m_intent.flow = i < world.player_flows.size() ? world.player_flows[i] : nullptr;
+            }
+        }
+    metric = abs(world.eagle.x - dest_rect.x) + abs(world.eagle.y - dest_rect.y);
+    if(metric < min_metric)
+    {
+        m_intent.chased = -1;
+        m_intent.target = {world.eagle.x + world.eagle.w / 2, world.eagle.y + world.eagle.h / 2};
+        m_intent.flow = world.eagle_flow;
+    }
+}
+
+Uint32 Enemy::random()
+{
+    // xorshift
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
+
+Enemy::ShotOutcome Enemy::aimShot(const LevelMap *map, Direction heading, SDL_Point target) const
+{
+    int dx = target.x - (dest_rect.x + dest_rect.w / 2);
+    int dy = target.y - (dest_rect.y + dest_rect.h / 2);
+    bool vertical = heading == D_UP || heading == D_DOWN;
+    int ahead = 0;
+    switch(heading)
+    {
+    case D_UP: ahead = -dy; break;
+    case D_RIGHT: ahead = dx; break;
+    case D_DOWN: ahead = dy; break;
+    case D_LEFT: ahead = -dx; break;
+    }
+    bool aligned = target.x > 0 && target.y > 0 && ahead > 0 && abs(vertical ? dx : dy) < (vertical ? dest_rect.w : dest_rect.h);
+
+    // without the map the shot is judged only by the direction of the target, like before the map was known to enemies
+    if(map == nullptr) return aligned ? SO_TARGET : SO_BRICK;
+
+    // the bullet of 8 pixels flies from the middle of the tank and overlaps one or two lines of cells
+    const int tile = vertical ? AppConfig::tile_rect.h : AppConfig::tile_rect.w;
+    int middle = vertical ? dest_rect.x + dest_rect.w / 2 : dest_rect.y + dest_rect.h / 2;
+    int first_line = (middle - 4) / (vertical ? AppConfig::tile_rect.w : AppConfig::tile_rect.h);
+    int last_line = (middle + 3) / (vertical ? AppConfig::tile_rect.w : AppConfig::tile_rect.h);
+    if((heading == D_UP && dest_rect.y < 1) || (heading == D_LEFT && dest_rect.x < 1)) return SO_WASTED;
+    int front;
+    switch(heading)
+    {
+    case D_UP: front = (dest_rect.y - 1) / tile; break;
+    case D_RIGHT: front = (dest_rect.x + dest_rect.w) / tile; break;
+    case D_DOWN: front = (dest_rect.y + dest_rect.h) / tile; break;
+    default: front = (dest_rect.x - 1) / tile; break;
+    }
+
+    int range = -1, wall_line = first_line;
+    for(int line = first_line; line <= last_line; line++)
+    {
+        int r = vertical ? map->bulletRange(front, line, heading) : map->bulletRange(line, front, heading);
+        if(range < 0 || r < range)
+        {
+            range = r;
+            wall_line = line;
+        }
+    }
+
+    // the target is hit if its middle is closer than the wall, counted in cells from the front of the tank
+    if(aligned && (ahead - (vertical ? dest_rect.h : dest_rect.w) / 2) / tile <= range) return SO_TARGET;
+
+    int step = (heading == D_DOWN || heading == D_RIGHT) ? range : -range;
+    int row = vertical ? front + step : wall_line, column = vertical ? wall_line : front + step;
+    if(row < 0 || column < 0 || row >= map->rows() || column >= map->columns()) return SO_WASTED;
+    Object* wall = map->tile(row, column);
+    if(wall == nullptr || wall->type != ST_BRICK_WALL) return SO_WASTED;
+    return aligned ? SO_BRICK_BEFORE_TARGET : SO_BRICK;
+}
+
+void Enemy::followFlow()
+{
+    SDL_Point position = FlowField::positionOf(dest_rect);
+    Direction d;
+    if(!flow_field->direction(position.x, position.y, d) || d == direction) return;
+    if(testFlag(TSF_ON_ICE) && d == new_direction) return;
+
+    // the same margin within which Tank::setDirection aligns the tank to the grid
+    const int margin = 5;
+    bool across = (d - direction) % 2 != 0;
+    int offset = (d == D_UP || d == D_DOWN) ? dest_rect.x - position.x * AppConfig::tile_rect.w : dest_rect.y - position.y * AppConfig::tile_rect.h;
+    if(across && abs(offset) >= margin) return;
+    setDirection(d);
 }
 
 void Enemy::destroy()
@@ -3,10 +3,41 @@
 
 #include "tank.h"
 
+class FlowField;
+class LevelMap;
+
+/**
+ * @brief
+ * World as seen by thinking enemies. Nothing in it changes while enemies think, so they may think on several threads at once.
+ */
+struct WorldSnapshot
+{
+    /**
+     * Map of the level, used to check what bullets would hit; @a nullptr if enemies fire blindly
+     */
+    const LevelMap* map;
+    /**
+     * Rectangle of the eagle
+     */
+    SDL_Rect eagle;
+    /**
+     * Routes toward the eagle, @a nullptr if they are unknown
+     */
+    const FlowField* eagle_flow;
+    /**
+     * Rectangles of the players
+     */
+    std::vector<SDL_Rect> players;
+    /**
+     * Routes toward the players in the order of @a players; a field may still lead to a cell its player has just left
+     */
+    std::vector<const FlowField*> player_flows;
+};
+
 /**
  * @brief Class responsible for the movements of enemy tanks
  */
-class Enemy : public Tank
+class Enemy final : public Tank
 {
 public:
     /**
@@ -20,17 +51,33 @@ public:
      * @param y - initial vertical position
      * @param type - type of enemy tank
      */
-    Enemy(double x, double y, SpriteType type);
+    Enemy(int x, int y, SpriteType type);
 
     /**
      * The function draws the enemy tank and, if the flag @a AppConfig::show_enemy_target is set, it draws a line connecting the tank to its target.
      */
     void draw();
     /**
-     * The function updates the tank's position and decides on the direction and timing of the next shot depending on the type of enemy
+     * The function updates the tank's position and timers every tick and keeps the tank on its route; decisions are left to @a think
      * @param dt - time since the last function call
      */
     void update(Uint32 dt);
+    /**
+     * The function chooses the target and decides on the direction and timing of the next shot depending on the type of enemy. It is called
+     * by the AI scheduler of the game, possibly less often than @a update; the timers it checks keep running in @a update meanwhile.
+     * The decision is only remembered and takes effect in @a apply: the function changes nothing but its own random generator, so
+     * several enemies may think at once on different threads.
+     * @param world - state of the world the decision is based on
+     */
+    void think(const WorldSnapshot& world);
+    /**
+     * The function carries out the decision of the last @a think: turning, firing and setting the new target and timers
+     */
+    void apply();
+    /**
+     * @return index of the player chosen as the target by the last @a think, -1 if it is the eagle or there was no decision
+     */
+    int chasedPlayer() const;
     /**
      * Decrease the armor level by 1. If the armor level reaches zero, the tank explodes (is destroyed).
      */
@@ -45,8 +92,81 @@ public:
      * The position towards which the enemy tank is heading
      */
     SDL_Point target_position;
+    /**
+     * Routes toward @a target_position, @a nullptr if the routes are unknown
+     */
+    const FlowField* flow_field;
 
 private:
+    /**
+     * Decision of the enemy made by @a think and carried out by @a apply
+     */
+    struct Intent
+    {
+        /**
+         * Whether a target was chosen; the other fields are valid only if it was
+         */
+        bool targeted;
+        SDL_Point target;
+        const FlowField* flow;
+        /**
+         * Index of the chased player, -1 for the eagle
+         */
+        int chased;
+        /**
+         * Whether the tank decided on its direction and shot; a frozen tank only follows its target
+         */
+        bool decided;
+        /**
+         * Whether the direction changes, together with the new direction and the time of keeping it
+         */
+        bool turn;
+        Direction direction;
+        Uint32 keep_direction_time;
+        bool follow_flow;
+        /**
+         * Whether the tank reloads, together with the new reload time and whether it fires
+         */
+        bool reload;
+        Uint32 reload_time;
+        bool fire;
+    };
+
+    /**
+     * What a bullet fired in the current direction would hit first
+     */
+    enum ShotOutcome
+    {
+        SO_WASTED,  ///< a stone wall or the border of the map
+        SO_BRICK,   ///< a brick wall, which opens the way
+        SO_BRICK_BEFORE_TARGET, ///< a brick wall between the tank and its target
+        SO_TARGET   ///< the target, before any wall
+    };
+    /**
+     * Checking the line of fire on the grid of the map: the bullet flies along the lane of cells it overlaps from the front of the tank
+     * @param map - map of the level, @a nullptr if only the direction of the target is known
+     * @param heading - direction of the shot
+     * @param target - position of the target in pixels
+     * @return outcome of a shot fired now
+     */
+    ShotOutcome aimShot(const LevelMap* map, Direction heading, SDL_Point target) const;
+    /**
+     * Choosing the eagle or, for some types, the closest player if it is closer than the eagle as the target of @a m_intent
+     * @param world - state of the world
+     */
+    void chooseTarget(const WorldSnapshot& world);
+    /**
+     * Drawing the next number of the generator of the enemy. Every enemy has its own generator seeded when it is created,
+     * so the decisions do not depend on the order in which enemies think.
+     * @return pseudo-random number
+     */
+    Uint32 random();
+    /**
+     * Turning the tank into the direction of the flow field at its current position. A turn across the current direction waits until
+     * the tank is close enough to the grid to be aligned by @a Tank::setDirection, so the tank does not scrape along walls.
+     */
+    void followFlow();
+
     /**
      * Time since the last direction change
      */
@@ -73,6 +193,22 @@ private:
      * Time after which the next firing attempt will occur
      */
     Uint32 m_reload_time;
+    /**
+     * Whether the tank follows @a flow_field until the next direction change
+     */
+    bool m_follow_flow;
+    /**
+     * Whether the tank has collided with something since the last decision
+     */
+    bool m_blocked;
+    /**
+     * State of the generator drawing the random decisions of the enemy, never 0
+     */
+    Uint32 m_random;
+    /**
+     * Decision of the last @a think
+     */
+    Intent m_intent;
 };
 
 #endif // ENEMY_H
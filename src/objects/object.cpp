@@ -5,22 +5,25 @@
 
 Object::Object()
 {
-    pos_x = 0.0;
-    pos_y = 0.0;
+    pos_x = 0;
+    pos_y = 0;
     type = ST_NONE;
     to_erase = false;
     m_sprite = nullptr;
+    m_frames = nullptr;
     m_frame_display_time = 0;
     m_current_frame = 0;
+    m_drawn_rect = {0, 0, 0, 0};
+    m_drawn_frame = 0;
 }
 
-Object::Object(double x, double y, SpriteType type)
+Object::Object(int x, int y, SpriteType type)
 {
-    pos_x = x;
-    pos_y = y;
+    pos_x = intToFixed(x);
+    pos_y = intToFixed(y);
     this->type = type;
     to_erase = false;
-    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(type);
+    setSprite(Engine::getEngine().getSpriteConfig()->getSpriteData(type));
     m_frame_display_time = 0;
     m_current_frame = 0;
 
@@ -29,24 +32,27 @@ Object::Object(double x, double y, SpriteType type)
     src_rect.h = m_sprite->rect.h;
     src_rect.w = m_sprite->rect.w;
 
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = x;
+    dest_rect.y = y;
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
-    collision_rect.x = pos_x;
-    collision_rect.y = pos_y;
+    collision_rect.x = x;
+    collision_rect.y = y;
     collision_rect.h = m_sprite->rect.h;
     collision_rect.w = m_sprite->rect.w;
+
+    m_drawn_rect = dest_rect;
+    m_drawn_frame = 0;
 }
 
-Object::Object(double x, double y, const SpriteData *sprite)
+Object::Object(int x, int y, const SpriteData *sprite)
 {
-    pos_x = x;
-    pos_y = y;
+    pos_x = intToFixed(x);
+    pos_y = intToFixed(y);
     this->type = type;
     to_erase = false;
-    m_sprite = sprite;
+    setSprite(sprite);
     m_frame_display_time = 0;
     m_current_frame = 0;
 
@@ -55,15 +61,18 @@ Object::Object(double x, double y, const SpriteData *sprite)
     src_rect.h = m_sprite->rect.h;
     src_rect.w = m_sprite->rect.w;
 
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = x;
+    dest_rect.y = y;
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
-    collision_rect.x = pos_x;
-    collision_rect.y = pos_y;
+    collision_rect.x = x;
+    collision_rect.y = y;
     collision_rect.h = m_sprite->rect.h;
     collision_rect.w = m_sprite->rect.w;
+
+    m_drawn_rect = dest_rect;
+    m_drawn_frame = 0;
 }
 
 Object::~Object()
@@ -72,51 +81,24 @@ Object::~Object()
 
 void Object::draw()
 {
-    if(m_sprite == nullptr || to_erase) return;
-    Engine::getEngine().getRenderer()->drawObject(&src_rect, &dest_rect);
+    drawSprite();
 }
 
 void Object::update(Uint32 dt)
 {
     if(to_erase) return;
 
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = fixedToInt(pos_x);
+    dest_rect.y = fixedToInt(pos_y);
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
-    collision_rect.x = pos_x;
-    collision_rect.y = pos_y;
+    collision_rect.x = dest_rect.x;
+    collision_rect.y = dest_rect.y;
     collision_rect.h = m_sprite->rect.h;
     collision_rect.w = m_sprite->rect.w;
 
-    if(m_sprite->frames_count > 1)
-    {
-        m_frame_display_time += dt;
-        if(m_frame_display_time > m_sprite->frame_duration)
-        {
-            m_frame_display_time = 0;
-            m_current_frame++;
-            if(m_current_frame >= m_sprite->frames_count)
-            {
-                if(m_sprite->loop) m_current_frame = 0;
-                else m_current_frame = m_sprite->frames_count - 1;
-            }
-
-            src_rect = moveRect(m_sprite->rect, 0, m_current_frame);
-        }
-    }
-}
-
-SDL_Rect Object::moveRect(const SDL_Rect &rect, int x, int y)
-{
-    SDL_Rect r;
-    r.x = rect.x + x*rect.w;
-    r.y = rect.y + y*rect.h;
-    r.w = rect.w;
-    r.h = rect.h;
-
-    return r;
+    animate(dt);
 }
 
 SDL_Rect intersectRect(SDL_Rect *rect1, SDL_Rect *rect2)
@@ -16,18 +16,18 @@ public:
     Object();
     /**
      * Creating an object
-     * @param x - initial horizontal position
-     * @param y - initial vertical position
+     * @param x - initial horizontal position in pixels
+     * @param y - initial vertical position in pixels
      * @param type - type of object
      */
-    Object(double x, double y, SpriteType type);
+    Object(int x, int y, SpriteType type);
     /**
      * Creating an object
-     * @param x - initial horizontal position
-     * @param y - initial vertical position
+     * @param x - initial horizontal position in pixels
+     * @param y - initial vertical position in pixels
      * @param sprite - animation of an object of a given type
      */
-    Object(double x, double y, const SpriteData* sprite);
+    Object(int x, int y, const SpriteData* sprite);
     virtual ~Object();
 
     /**
@@ -39,6 +39,22 @@ public:
      * @param dt - time since the last function call, used for counting the frame display time
      */
     virtual void update(Uint32 dt);
+    /**
+     * Counting down the display time of one animation frame and changing the frame after the appropriate time has elapsed.
+     * Unlike @a update the function is not virtual and does not touch dest_rect and collision_rect, so it can be used for batches of motionless objects of a known type.
+     * @param dt - time since the last function call
+     */
+    inline void animate(Uint32 dt);
+    /**
+     * Setting the frame of a looped animation driven by a shared @a AnimationClock instead of @a animate
+     * @param frame - number of the frame
+     */
+    inline void setFrame(int frame);
+    /**
+     * Drawing the current animation frame without virtual dispatch; used for batches of map tiles and bushes.
+     * If the object was drawn in the previous frame, its motion since then is passed to the renderer for interpolation.
+     */
+    inline void drawSprite();
 
     /**
      * A variable indicates whether the object should be deleted. If the variable is equal to @a true, then updating and drawing the object is skipped.
@@ -61,28 +77,36 @@ public:
      */
     SpriteType type;
     /**
-     * Exact horizontal position of the object
+     * Exact horizontal position of the object in the @a Fixed format
      */
-    double pos_x;
+    Fixed pos_x;
     /**
-     * Exact vertical position of the object
+     * Exact vertical position of the object in the @a Fixed format
      */
-    double pos_y;
+    Fixed pos_y;
 
 protected:
     /**
-     * The function returns a rectangle shifted by a multiple of the size of the rectangle rect
-     * @param rect - base rectangle
-     * @param x - horizontal shift
-     * @param y - vertical shift
-     * @return shifted rectangle
+     * Changing the animation of the object; the first variant of the animation is selected
+     * @param sprite - new animation
+     */
+    inline void setSprite(const SpriteData* sprite);
+    /**
+     * Selecting the frame table of a variant of the current animation; @a src_rect is not changed.
+     * A variant the animation does not have (e.g. a direction of the tank while it is being created) is ignored.
+     * @param column - variant of the sprite, e.g. direction
+     * @param first_row - row of the first frame of the variant
      */
-    SDL_Rect moveRect(const SDL_Rect &rect, int x, int y);
+    inline void setVariant(int column, int first_row = 0);
 
     /**
      * Animation corresponding to a given type of object
      */
     const SpriteData* m_sprite;
+    /**
+     * Source rectangles of frames of the current variant of the animation, precomputed by @a SpriteConfig
+     */
+    const SDL_Rect* m_frames;
     /**
      * Display time of the current animation frame
      */
@@ -91,6 +115,14 @@ protected:
      * Number of the current animation frame
      */
     int m_current_frame;
+    /**
+     * Position of the object on the screen in the last drawn frame
+     */
+    SDL_Rect m_drawn_rect;
+    /**
+     * Number of the last frame in which the object was drawn
+     */
+    unsigned m_drawn_frame;
 };
 
 /**
@@ -101,4 +133,52 @@ protected:
  */
 SDL_Rect intersectRect(SDL_Rect* rect1, SDL_Rect* rect2);
 
+void Object::animate(Uint32 dt)
+{
+    if(m_sprite->frames_count <= 1) return;
+
+    m_frame_display_time += dt;
+    if(m_frame_display_time > m_sprite->frame_duration)
+    {
+        m_frame_display_time = 0;
+        m_current_frame++;
+        if(m_current_frame >= m_sprite->frames_count)
+        {
+            if(m_sprite->loop) m_current_frame = 0;
+            else m_current_frame = m_sprite->frames_count - 1;
+        }
+
+        src_rect = m_frames[m_current_frame];
+    }
+}
+
+void Object::setFrame(int frame)
+{
+    m_current_frame = frame;
+    src_rect = m_frames[frame];
+}
+
+void Object::setSprite(const SpriteData *sprite)
+{
+    m_sprite = sprite;
+    m_frames = Engine::getEngine().getSpriteConfig()->variantFrames(sprite, 0);
+}
+
+void Object::setVariant(int column, int first_row)
+{
+    const SDL_Rect* frames = Engine::getEngine().getSpriteConfig()->variantFrames(m_sprite, column, first_row);
+    if(frames != nullptr) m_frames = frames;
+}
+
+void Object::drawSprite()
+{
+    if(m_sprite == nullptr || to_erase) return;
+
+    Renderer* renderer = Engine::getEngine().getRenderer();
+    unsigned frame = renderer->frameNumber();
+    renderer->drawObject(&src_rect, &dest_rect, m_drawn_frame + 1 == frame ? &m_drawn_rect : nullptr);
+    m_drawn_rect = dest_rect;
+    m_drawn_frame = frame;
+}
+
 #endif // OBJECT_H
@@ -6,6 +6,7 @@
 Player::Player()
     : Tank(AppConfig::player_starting_point.at(0).x, AppConfig::player_starting_point.at(0).y, ST_PLAYER_1)
 {
+    starting_point = AppConfig::player_starting_point.at(0);
     speed = 0;
     lives_count = 11;
     m_bullet_max_size = AppConfig::player_bullet_max_size;
@@ -16,9 +17,10 @@ Player::Player()
     respawn();
 }
 
-Player::Player(double x, double y, SpriteType type)
+Player::Player(int x, int y, SpriteType type)
     : Tank(x, y, type)
 {
+   starting_point = {x, y};
    speed = 0;
    lives_count = 11;
    m_bullet_max_size = AppConfig::player_bullet_max_size;
@@ -31,7 +33,7 @@ Player::Player(double x, double y, SpriteType type)
 
 void Player::update(Uint32 dt)
 {
-    const Uint8 *key_state = SDL_GetKeyboardState(NULL);
+    const Uint8 *key_state = Engine::getEngine().getInput()->keyboardState();
 
     Tank::update(dt);
 
@@ -60,7 +62,7 @@ void Player::update(Uint32 dt)
         else
         {
             if(!testFlag(TSF_ON_ICE) || m_slip_time == 0)
-                speed = 0.0;
+                speed = 0;
         }
 
         if(key_state[player_keys.fire] && m_fire_time > AppConfig::player_reload_time)
@@ -72,10 +74,10 @@ void Player::update(Uint32 dt)
 
     m_fire_time += dt;
 
+    // frames of each star level are placed below the frames of the previous one
     if(testFlag(TSF_LIFE))
-        src_rect = moveRect(m_sprite->rect, (testFlag(TSF_ON_ICE) ? new_direction : direction), m_current_frame + 2 * star_count);
-    else
-        src_rect = moveRect(m_sprite->rect, 0, m_current_frame + 2 * star_count);
+        setVariant(testFlag(TSF_ON_ICE) ? new_direction : direction, 2 * star_count);
+    src_rect = m_frames[m_current_frame];
 
     stop = false;
 }
@@ -89,19 +91,11 @@ void Player::respawn()
         return;
     }
 
-    if(type == ST_PLAYER_1)
-    {
-        pos_x = AppConfig::player_starting_point.at(0).x;
-        pos_y = AppConfig::player_starting_point.at(0).y;
-    }
-    else
-    {
-        pos_x = AppConfig::player_starting_point.at(1).x;
-        pos_y = AppConfig::player_starting_point.at(1).y;
-    }
+    pos_x = intToFixed(starting_point.x);
+    pos_y = intToFixed(starting_point.y);
 
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = starting_point.x;
+    dest_rect.y = starting_point.y;
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
@@ -134,7 +128,7 @@ Bullet* Player::fire()
     Bullet* b = Tank::fire();
     if(b != nullptr)
     {
-        if(star_count > 0) b->speed = AppConfig::bullet_default_speed * 1.3;
+        if(star_count > 0) b->speed = AppConfig::bullet_default_speed * 13 / 10;
         if(star_count == 3) b->increased_damage = true;
     }
     return b;
@@ -149,6 +143,6 @@ void Player::changeStarCountBy(int c)
     if(star_count >= 2 && c > 0) m_bullet_max_size++;
     else m_bullet_max_size = 2;
 
-    if(star_count > 0) default_speed = AppConfig::tank_default_speed * 1.3;
+    if(star_count > 0) default_speed = AppConfig::tank_default_speed * 13 / 10;
     else default_speed = AppConfig::tank_default_speed;
 }
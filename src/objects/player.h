@@ -6,7 +6,7 @@
 /**
  * @brief Class corresponding to player tanks
  */
-class Player : public Tank
+class Player final : public Tank
 {
 public:
 
@@ -46,11 +46,11 @@ public:
     Player();
     /**
      * Creating a player’s tank
-     * @param x - initial horizontal position
-     * @param y - initial vertical position
+     * @param x - initial horizontal position, also used as the starting point
+     * @param y - initial vertical position, also used as the starting point
      * @param type - player type
      */
-    Player(double x, double y, SpriteType type);
+    Player(int x, int y, SpriteType type);
 
     /**
      * The function is responsible for changing the player tank’s animation as well as checking the state of pressed keys and reacting to those keys that control the player’s tank
@@ -79,6 +79,10 @@ public:
      */
     void changeStarCountBy(int c);
 
+    /**
+     * Position at which the tank appears after respawning
+     */
+    SDL_Point starting_point;
     /**
      * Keys controlling the movements of the current player
      */
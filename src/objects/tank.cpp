@@ -8,20 +8,20 @@ Tank::Tank()
     direction = D_UP;
     m_slip_time = 0;
     default_speed = AppConfig::tank_default_speed;
-    speed = 0.0;
+    speed = 0;
     m_shield = nullptr;
     m_boat = nullptr;
     m_shield_time = 0;
     m_frozen_time = 0;
 }
 
-Tank::Tank(double x, double y, SpriteType type)
+Tank::Tank(int x, int y, SpriteType type)
     : Object(x, y, type)
 {
     direction = D_UP;
     m_slip_time = 0;
     default_speed = AppConfig::tank_default_speed;
-    speed = 0.0;
+    speed = 0;
     m_shield = nullptr;
     m_boat = nullptr;
     m_shield_time = 0;
@@ -64,25 +64,26 @@ void Tank::update(Uint32 dt)
     {
         if(!stop && !testFlag(TSF_FROZEN))
         {
+            Fixed distance = speed * static_cast<Fixed>(dt);
             switch (direction)
             {
             case D_UP:
-                pos_y -= speed * dt;
+                pos_y -= distance;
                 break;
             case D_RIGHT:
-                pos_x += speed * dt;
+                pos_x += distance;
                 break;
             case D_DOWN:
-                pos_y += speed * dt;
+                pos_y += distance;
                 break;
             case D_LEFT:
-                pos_x -= speed * dt;
+                pos_x -= distance;
                 break;
             }
         }
 
-        dest_rect.x = pos_x;
-        dest_rect.y = pos_y;
+        dest_rect.x = fixedToInt(pos_x);
+        dest_rect.y = fixedToInt(pos_y);
         dest_rect.h = m_sprite->rect.h;
         dest_rect.w = m_sprite->rect.w;
 
@@ -135,7 +136,7 @@ void Tank::update(Uint32 dt)
                 if(m_sprite->loop) m_current_frame = 0;
                 else if(testFlag(TSF_CREATE))
                 {
-                    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(type);
+                    setSprite(Engine::getEngine().getSpriteConfig()->getSpriteData(type));
                     clearFlag(TSF_CREATE);
                     setFlag(TSF_LIFE);
                     m_current_frame = 0;
@@ -162,33 +163,35 @@ Bullet* Tank::fire()
     if(bullets.size() < m_bullet_max_size)
     {
         // We provide an arbitrary initial position because the dimensions of the projectile are unknown
-        Bullet* bullet = new Bullet(pos_x, pos_y);
+        Bullet* bullet = new Bullet(0, 0);
+        bullet->pos_x = pos_x;
+        bullet->pos_y = pos_y;
         bullets.push_back(bullet);
 
         Direction tmp_d = (testFlag(TSF_ON_ICE) ? new_direction : direction);
         switch(tmp_d)
         {
         case D_UP:
-            bullet->pos_x += (dest_rect.w - bullet->dest_rect.w) / 2;
-            bullet->pos_y -= bullet->dest_rect.h - 4;
+            bullet->pos_x += intToFixed((dest_rect.w - bullet->dest_rect.w) / 2);
+            bullet->pos_y -= intToFixed(bullet->dest_rect.h - 4);
             break;
         case D_RIGHT:
-            bullet->pos_x += dest_rect.w - 4;
-            bullet->pos_y += (dest_rect.h - bullet->dest_rect.h) / 2;
+            bullet->pos_x += intToFixed(dest_rect.w - 4);
+            bullet->pos_y += intToFixed((dest_rect.h - bullet->dest_rect.h) / 2);
             break;
         case D_DOWN:
-            bullet->pos_x += (dest_rect.w - bullet->dest_rect.w) / 2;
-            bullet->pos_y += dest_rect.h - 4;
+            bullet->pos_x += intToFixed((dest_rect.w - bullet->dest_rect.w) / 2);
+            bullet->pos_y += intToFixed(dest_rect.h - 4);
             break;
         case D_LEFT:
-            bullet->pos_x -= bullet->dest_rect.w - 4;
-            bullet->pos_y += (dest_rect.h - bullet->dest_rect.h) / 2;
+            bullet->pos_x -= intToFixed(bullet->dest_rect.w - 4);
+            bullet->pos_y += intToFixed((dest_rect.h - bullet->dest_rect.h) / 2);
             break;
         }
 
         bullet->direction = tmp_d;
         if(type == ST_TANK_C)
-            bullet->speed = AppConfig::bullet_default_speed * 1.3;
+            bullet->speed = AppConfig::bullet_default_speed * 13 / 10;
         else
             bullet->speed = AppConfig::bullet_default_speed;
 
@@ -204,22 +207,23 @@ SDL_Rect Tank::nextCollisionRect(Uint32 dt)
 
     SDL_Rect r;
     int a = 1;
+    Fixed distance = default_speed * static_cast<Fixed>(dt);
     switch (direction)
     {
     case D_UP:
         r.x = collision_rect.x;
-        r.y = collision_rect.y - default_speed * dt - a;
+        r.y = fixedToInt(intToFixed(collision_rect.y) - distance) - a;
         break;
     case D_RIGHT:
-        r.x = collision_rect.x + default_speed * dt + a;
+        r.x = fixedToInt(intToFixed(collision_rect.x) + distance) + a;
         r.y = collision_rect.y;
         break;
     case D_DOWN:
         r.x = collision_rect.x;
-        r.y = collision_rect.y + default_speed * dt + a;
+        r.y = fixedToInt(intToFixed(collision_rect.y) + distance) + a;
         break;
     case D_LEFT:
-        r.x = collision_rect.x - default_speed * dt - a;
+        r.x = fixedToInt(intToFixed(collision_rect.x) - distance) - a;
         r.y = collision_rect.y;
         break;
     }
@@ -235,7 +239,7 @@ void Tank::setDirection(Direction d)
     if(testFlag(TSF_ON_ICE))
     {
         new_direction = d;
-        if(speed == 0.0 || m_slip_time == 0.0) direction = d;
+        if(speed == 0 || m_slip_time == 0) direction = d;
         if((m_slip_time != 0 && direction == new_direction) || m_slip_time == 0)
             m_slip_time = AppConfig::slip_time;
     }
@@ -244,21 +248,23 @@ void Tank::setDirection(Direction d)
 
     if(!stop)
     {
-        double epsilon = 5;
-        int pos_x_tile, pos_y_tile;
+        const Fixed epsilon = intToFixed(5);
+        const Fixed tile_w = intToFixed(AppConfig::tile_rect.w);
+        const Fixed tile_h = intToFixed(AppConfig::tile_rect.h);
+        Fixed pos_x_tile, pos_y_tile;
         switch (direction)
         {
         case D_UP:
         case D_DOWN:
-            pos_x_tile = ((int)(pos_x / AppConfig::tile_rect.w)) * AppConfig::tile_rect.w;
+            pos_x_tile = pos_x / tile_w * tile_w;
             if(pos_x - pos_x_tile < epsilon) pos_x = pos_x_tile;
-            else if(pos_x_tile + AppConfig::tile_rect.w - pos_x < epsilon) pos_x = pos_x_tile + AppConfig::tile_rect.w;
+            else if(pos_x_tile + tile_w - pos_x < epsilon) pos_x = pos_x_tile + tile_w;
             break;
         case D_RIGHT:
         case D_LEFT:
-            pos_y_tile = ((int)(pos_y / AppConfig::tile_rect.h)) * AppConfig::tile_rect.h;
+            pos_y_tile = pos_y / tile_h * tile_h;
             if(pos_y - pos_y_tile < epsilon) pos_y = pos_y_tile;
-            else if(pos_y_tile + AppConfig::tile_rect.h - pos_y < epsilon) pos_y = pos_y_tile + AppConfig::tile_rect.h;
+            else if(pos_y_tile + tile_h - pos_y < epsilon) pos_y = pos_y_tile + tile_h;
             break;
         }
     }
@@ -298,15 +304,15 @@ void Tank::destroy()
     direction = D_UP;
     speed = 0;
     m_slip_time = 0;
-    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_TANK);
+    setSprite(Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_TANK));
 
     collision_rect.x = 0;
     collision_rect.y = 0;
     collision_rect.h = 0;
     collision_rect.w = 0;
 
-    dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w)/2;
-    dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h)/2;
+    dest_rect.x = fixedToInt(pos_x) + (dest_rect.w - m_sprite->rect.w)/2;
+    dest_rect.y = fixedToInt(pos_y) + (dest_rect.h - m_sprite->rect.h)/2;
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 }
@@ -318,12 +324,12 @@ void Tank::setFlag(TankStateFlag flag)
 
     if(flag == TSF_SHIELD)
     {
-        if(m_shield == nullptr) m_shield = new Object(pos_x, pos_y, ST_SHIELD);
+        if(m_shield == nullptr) m_shield = new Object(fixedToInt(pos_x), fixedToInt(pos_y), ST_SHIELD);
          m_shield_time = 0;
     }
     if(flag == TSF_BOAT)
     {
-         if(m_boat == nullptr) m_boat = new Object(pos_x, pos_y, type == ST_PLAYER_1 ? ST_BOAT_P1 : ST_BOAT_P2);
+         if(m_boat == nullptr) m_boat = new Object(fixedToInt(pos_x), fixedToInt(pos_y), type == ST_PLAYER_1 ? ST_BOAT_P1 : ST_BOAT_P2);
     }
     if(flag == TSF_FROZEN)
     {
@@ -359,8 +365,8 @@ bool Tank::testFlag(TankStateFlag flag)
 
 void Tank::respawn()
 {
-    m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_CREATE);
-    speed = 0.0;
+    setSprite(Engine::getEngine().getSpriteConfig()->getSpriteData(ST_CREATE));
+    speed = 0;
     stop = false;
     m_slip_time = 0;
 
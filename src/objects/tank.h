@@ -27,7 +27,7 @@ public:
      * @param y - initial vertical position
      * @param type - tank type
      */
-    Tank(double x, double y, SpriteType type);
+    Tank(int x, int y, SpriteType type);
     virtual ~Tank();
 
     /**
@@ -88,13 +88,13 @@ public:
     bool testFlag(TankStateFlag flag);
 
     /**
-     * The default speed of a given tank. It may vary for different types of tanks or can be changed after the player picks up a bonus
+     * The default speed of a given tank in pixels per millisecond, in the @a Fixed format. It may vary for different types of tanks or can be changed after the player picks up a bonus
      */
-    double default_speed;
+    Fixed default_speed;
     /**
-     * Current speed of the tank
+     * Current speed of the tank in pixels per millisecond, in the @a Fixed format
      */
-    double speed;
+    Fixed speed;
     /**
      * The variable stores information about whether the tank is currently stopped
      */
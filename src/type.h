@@ -68,4 +68,39 @@ enum Direction
     D_LEFT = 3
 };
 
+/**
+ * Fixed-point number with 16 fractional bits. Positions and speeds of moving objects are stored in this format,
+ * so the simulation uses only integer arithmetic and gives the same results on every compiler and processor.
+ */
+typedef int Fixed;
+
+/**
+ * Number of fractional bits of the @a Fixed type
+ */
+const int FIXED_SHIFT = 16;
+/**
+ * Value 1 in the @a Fixed format
+ */
+const Fixed FIXED_ONE = 1 << FIXED_SHIFT;
+
+/**
+ * Conversion of the integer number to the fixed-point format
+ * @param value - integer number
+ * @return number in the @a Fixed format
+ */
+inline Fixed intToFixed(int value)
+{
+    return value * FIXED_ONE;
+}
+
+/**
+ * Conversion of the fixed-point number to the integer number. The fractional part is discarded in the same way as when converting @a double to @a int.
+ * @param value - number in the @a Fixed format
+ * @return integer part of the number
+ */
+inline int fixedToInt(Fixed value)
+{
+    return value / FIXED_ONE;
+}
+
 #endif // TYPE_H
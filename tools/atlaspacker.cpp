@@ -0,0 +1,295 @@
+/**
+ * Atlas packer: cuts every frame of the sprites listed in a sprite description file out of their source images,
+ * packs the frames into a single texture atlas and writes the atlas image together with a binary manifest loaded by @a SpriteConfig::load.
+ *
+ * Usage: atlaspacker SPRITES ATLAS_IMAGE MANIFEST
+ *
+ * Every frame is surrounded by a 1 pixel border repeating its edge pixels, so scaled drawing never samples a neighbouring frame.
+ * Identical frames (the same region of the same image) are stored once. The dimensions of the atlas are powers of two.
+ */
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Animation read from the sprite description file
+ */
+struct Sprite
+{
+    std::string name;
+    std::string image;
+    int x, y, w, h;
+    int frames_count;
+    int frame_duration;
+    int loop;
+    int first_column;
+    int columns;
+    int rows;
+    /**
+     * Indexes of packed cells of all frames, columns one after another
+     */
+    std::vector<int> cells;
+};
+
+/**
+ * Region of a source image placed in the atlas
+ */
+struct Cell
+{
+    SDL_Surface* image;
+    SDL_Rect src;
+    /**
+     * Position of the region in the atlas, without the border
+     */
+    SDL_Point position;
+};
+
+/**
+ * Border around every frame in pixels
+ */
+static const int bleed = 1;
+/**
+ * Largest atlas dimension that is tried
+ */
+static const int max_atlas_size = 8192;
+
+static void writeValue(FILE* file, Uint32 value, int size)
+{
+    Uint8 bytes[4];
+    for(int i = 0; i < size; i++)
+        bytes[i] = value >> (8 * i);
+    fwrite(bytes, 1, size, file);
+}
+
+static int nextPowerOfTwo(int value)
+{
+    int p = 1;
+    while(p < value) p *= 2;
+    return p;
+}
+
+/**
+ * Shelf packing of cells sorted by height: cells are placed in rows from left to right, a new shelf starts when a row is full
+ * @param cells - cells to place, positions are set
+ * @param order - indexes of cells sorted from the highest
+ * @param width - width of the atlas
+ * @return height used by the cells, or -1 if a cell is wider than the atlas
+ */
+static int packShelves(std::vector<Cell>& cells, const std::vector<int>& order, int width)
+{
+    int x = 0, y = 0, shelf_height = 0;
+    for(int index : order)
+    {
+        Cell& cell = cells[index];
+        int w = cell.src.w + 2 * bleed, h = cell.src.h + 2 * bleed;
+        if(w > width) return -1;
+        if(x + w > width)
+        {
+            x = 0;
+            y += shelf_height;
+            shelf_height = 0;
+        }
+        cell.position = {x + bleed, y + bleed};
+        x += w;
+        shelf_height = std::max(shelf_height, h);
+    }
+    return y + shelf_height;
+}
+
+/**
+ * Copying a cell to the atlas and repeating its edge pixels in the border
+ * @param atlas - atlas surface in the ARGB8888 format
+ * @param cell - placed cell; its image is in the ARGB8888 format
+ */
+static void copyCell(SDL_Surface* atlas, const Cell& cell)
+{
+    Uint32* out = static_cast<Uint32*>(atlas->pixels);
+    const Uint32* in = static_cast<const Uint32*>(cell.image->pixels);
+    int out_pitch = atlas->pitch / 4, in_pitch = cell.image->pitch / 4;
+
+    for(int y = -bleed; y < cell.src.h + bleed; y++)
+        for(int x = -bleed; x < cell.src.w + bleed; x++)
+        {
+            int sx = cell.src.x + std::min(std::max(x, 0), cell.src.w - 1);
+            int sy = cell.src.y + std::min(std::max(y, 0), cell.src.h - 1);
+            Uint32 pixel = 0;
+            if(sx >= 0 && sy >= 0 && sx < cell.image->w && sy < cell.image->h) pixel = in[sy * in_pitch + sx];
+            out[(cell.position.y + y) * out_pitch + cell.position.x + x] = pixel;
+        }
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc != 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " SPRITES ATLAS_IMAGE MANIFEST" << std::endl;
+        return 1;
+    }
+    std::string sprites_path = argv[1], atlas_path = argv[2], manifest_path = argv[3];
+    size_t separator = sprites_path.find_last_of("/\\");
+    std::string base_dir = separator == std::string::npos ? std::string() : sprites_path.substr(0, separator + 1);
+
+    std::ifstream input(sprites_path.c_str());
+    if(!input.is_open())
+    {
+        std::cerr << "Cannot read " << sprites_path << std::endl;
+        return 1;
+    }
+
+    std::vector<Sprite> sprites;
+    std::string line;
+    for(int line_number = 1; std::getline(input, line); line_number++)
+    {
+        if(line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        Sprite s;
+        if(!(fields >> s.name >> s.image >> s.x >> s.y >> s.w >> s.h >> s.frames_count >> s.frame_duration >> s.loop >> s.first_column >> s.columns >> s.rows) ||
+           s.w <= 0 || s.h <= 0 || s.columns <= 0 || s.rows < s.frames_count)
+        {
+            std::cerr << sprites_path << ":" << line_number << ": invalid sprite" << std::endl;
+            return 1;
+        }
+        sprites.push_back(s);
+    }
+
+    if(SDL_Init(0) != 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG))
+    {
+        std::cerr << "Cannot initialize SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    int result = 1;
+    std::map<std::string, SDL_Surface*> images;
+    std::vector<Cell> cells;
+    std::map<std::string, int> cell_indexes;
+    SDL_Surface* atlas = nullptr;
+    bool loaded = true;
+
+    for(Sprite& s : sprites)
+    {
+        SDL_Surface*& image = images[s.image];
+        if(image == nullptr)
+        {
+            SDL_Surface* surface = IMG_Load((base_dir + s.image).c_str());
+            if(surface != nullptr)
+            {
+                image = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(surface);
+            }
+            if(image == nullptr)
+            {
+                std::cerr << "Cannot load " << base_dir << s.image << ": " << IMG_GetError() << std::endl;
+                loaded = false;
+                break;
+            }
+        }
+
+        for(int c = 0; c < s.columns; c++)
+            for(int r = 0; r < s.rows; r++)
+            {
+                SDL_Rect src = {s.x + (s.first_column + c) * s.w, s.y + r * s.h, s.w, s.h};
+                std::ostringstream key;
+                key << s.image << ' ' << src.x << ' ' << src.y << ' ' << src.w << ' ' << src.h;
+                auto found = cell_indexes.find(key.str());
+                if(found == cell_indexes.end())
+                {
+                    found = cell_indexes.insert(std::make_pair(key.str(), static_cast<int>(cells.size()))).first;
+                    cells.push_back({image, src, {0, 0}});
+                }
+                s.cells.push_back(found->second);
+            }
+    }
+
+    if(loaded)
+    {
+        std::vector<int> order(cells.size());
+        for(unsigned i = 0; i < order.size(); i++) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&cells](int a, int b) {
+            return cells[a].src.h != cells[b].src.h ? cells[a].src.h > cells[b].src.h : cells[a].src.w > cells[b].src.w; });
+
+        // the width with the smallest power-of-two area wins; a narrower atlas is preferred when areas are equal
+        int best_width = 0, best_height = 0;
+        for(int width = 64; width <= max_atlas_size; width *= 2)
+        {
+            int height = packShelves(cells, order, width);
+            if(height < 0) continue;
+            height = nextPowerOfTwo(height);
+            if(height <= max_atlas_size && (best_width == 0 || width * height < best_width * best_height))
+            {
+                best_width = width;
+                best_height = height;
+            }
+        }
+
+        if(best_width == 0) std::cerr << "Sprites do not fit into a " << max_atlas_size << "x" << max_atlas_size << " atlas" << std::endl;
+        else
+        {
+            packShelves(cells, order, best_width);
+            atlas = SDL_CreateRGBSurface(0, best_width, best_height, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
+        }
+    }
+
+    if(atlas != nullptr)
+    {
+        SDL_FillRect(atlas, nullptr, 0);
+        for(const Cell& cell : cells)
+            copyCell(atlas, cell);
+
+        FILE* manifest = fopen(manifest_path.c_str(), "wb");
+        if(IMG_SavePNG(atlas, atlas_path.c_str()) != 0)
+            std::cerr << "Cannot write " << atlas_path << ": " << IMG_GetError() << std::endl;
+        else if(manifest == nullptr)
+            std::cerr << "Cannot write " << manifest_path << std::endl;
+        else
+        {
+            separator = atlas_path.find_last_of("/\\");
+            std::string atlas_name = separator == std::string::npos ? atlas_path : atlas_path.substr(separator + 1);
+
+            fwrite("TNKA", 1, 4, manifest);
+            writeValue(manifest, 1, 4);
+            writeValue(manifest, atlas->w, 4);
+            writeValue(manifest, atlas->h, 4);
+            writeValue(manifest, atlas_name.size(), 2);
+            fwrite(atlas_name.data(), 1, atlas_name.size(), manifest);
+            writeValue(manifest, sprites.size(), 4);
+            for(const Sprite& s : sprites)
+            {
+                writeValue(manifest, s.name.size(), 1);
+                fwrite(s.name.data(), 1, s.name.size(), manifest);
+                writeValue(manifest, s.frames_count, 4);
+                writeValue(manifest, s.frame_duration, 4);
+                writeValue(manifest, s.loop, 1);
+                writeValue(manifest, s.first_column, 4);
+                writeValue(manifest, s.columns, 4);
+                writeValue(manifest, s.rows, 4);
+                for(int index : s.cells)
+                {
+                    const Cell& cell = cells[index];
+                    writeValue(manifest, cell.position.x, 2);
+                    writeValue(manifest, cell.position.y, 2);
+                    writeValue(manifest, cell.src.w, 2);
+                    writeValue(manifest, cell.src.h, 2);
+                }
+            }
+            std::cout << "Packed " << cells.size() << " frames of " << sprites.size() << " sprites into a "
+                      << atlas->w << "x" << atlas->h << " atlas" << std::endl;
+            result = 0;
+        }
+        if(manifest != nullptr) fclose(manifest);
+        SDL_FreeSurface(atlas);
+    }
+
+    for(auto& image : images)
+        if(image.second != nullptr) SDL_FreeSurface(image.second);
+    IMG_Quit();
+    SDL_Quit();
+    return result;
+}
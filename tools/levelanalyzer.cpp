@@ -0,0 +1,186 @@
+/**
+ * Level analyzer: computes navigation and difficulty metrics of levels (@a LevelAnalyzer) on several threads and writes them as a report.
+ *
+ * Usage: levelanalyzer [--threads N] [--output REPORT] LEVEL...
+ *        levelanalyzer [--threads N] [--output REPORT] --pack PACK
+ *
+ * Levels may be text or compiled files, or all levels of a pack. The report holds one JSON object per line in the order of the levels:
+ * the size, the share of each kind of field, the cheapest route of enemies from every spawn point to the eagle (cost, steps and steps
+ * through brick walls, cost -1 if there is none), the number of choke points and the lanes from which the eagle can be shot.
+ */
+
+#include "../src/level/levelanalyzer.h"
+#include "../src/level/levelpack.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Analysis of one level
+ */
+struct Analysis
+{
+    /**
+     * Path of the level, or its number in the pack
+     */
+    std::string name;
+    /**
+     * Number of the level in the pack, 0 for level files
+     */
+    int number;
+    /**
+     * Whether the level was loaded and analyzed
+     */
+    bool analyzed;
+    LevelMetrics metrics;
+};
+
+/**
+ * Levels shared by the worker threads; each worker takes the next level until there is none
+ */
+struct Batch
+{
+    const LevelPack* pack;
+    std::vector<Analysis> levels;
+    SDL_atomic_t next;
+};
+
+static int analyzeThread(void* data)
+{
+    Batch* batch = static_cast<Batch*>(data);
+    LevelAnalyzer analyzer;
+    LevelData level;
+    for(;;)
+    {
+        int index = SDL_AtomicAdd(&batch->next, 1);
+        if(index >= static_cast<int>(batch->levels.size())) break;
+
+        Analysis& analysis = batch->levels[index];
+        bool loaded = batch->pack != nullptr ? batch->pack->level(analysis.number, level) : level.load(analysis.name) || level.loadText(analysis.name);
+        analysis.analyzed = loaded && analyzer.analyze(level, analysis.metrics);
+    }
+    return 0;
+}
+
+static std::string quoted(const std::string& text)
+{
+    std::string result = "\"";
+    for(char c : text)
+    {
+        if(c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+static void writeReport(std::ostream& output, const Analysis& analysis)
+{
+    static const char* tile_names[LT_COUNT] = {"empty", "brick", "stone", "bush", "water", "ice"};
+    const LevelMetrics& m = analysis.metrics;
+
+    output << "{\"level\":" << quoted(analysis.name) << ",\"width\":" << m.width << ",\"height\":" << m.height << ",\"density\":{";
+    for(int k = 0; k < LT_COUNT; k++)
+        output << (k ? "," : "") << "\"" << tile_names[k] << "\":" << m.density[k];
+    output << "},\"routes\":[";
+    for(unsigned i = 0; i < m.routes.size(); i++)
+    {
+        const SpawnRoute& r = m.routes[i];
+        output << (i ? "," : "") << "{\"x\":" << r.spawn.x << ",\"y\":" << r.spawn.y
+               << ",\"cost\":" << r.cost << ",\"steps\":" << r.steps << ",\"bricks\":" << r.bricks << "}";
+    }
+    output << "],\"choke_points\":" << m.choke_points << ",\"open_lanes\":" << m.open_lanes
+           << ",\"lane_cells\":" << m.lane_cells << ",\"lane_cells_without_bricks\":" << m.lane_cells_without_bricks << "}\n";
+}
+
+static int usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--threads N] [--output REPORT] LEVEL..." << std::endl;
+    std::cerr << "       " << name << " [--threads N] [--output REPORT] --pack PACK" << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    int thread_count = SDL_GetCPUCount();
+    std::string output_path, pack_path;
+    Batch batch;
+    batch.pack = nullptr;
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--threads" && i + 1 < argc) thread_count = atoi(argv[++i]);
+        else if(arg == "--output" && i + 1 < argc) output_path = argv[++i];
+        else if(arg == "--pack" && i + 1 < argc) pack_path = argv[++i];
+        else if(arg.size() > 1 && arg[0] == '-') return usage(argv[0]);
+        else batch.levels.push_back(Analysis{arg, 0, false, LevelMetrics()});
+    }
+    if(batch.levels.empty() == pack_path.empty()) return usage(argv[0]);
+
+    LevelPack pack;
+    if(!pack_path.empty())
+    {
+        if(!pack.open(pack_path))
+        {
+            std::cerr << "Cannot read " << pack_path << std::endl;
+            return 1;
+        }
+        batch.pack = &pack;
+        for(int number = 1; number <= pack.count(); number++)
+            batch.levels.push_back(Analysis{std::to_string(number), number, false, LevelMetrics()});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SDL_AtomicSet(&batch.next, 0);
+    thread_count = std::max(1, std::min(thread_count, static_cast<int>(batch.levels.size())));
+    std::vector<SDL_Thread*> threads;
+    for(int i = 1; i < thread_count; i++)
+    {
+        SDL_Thread* thread = SDL_CreateThread(analyzeThread, "level analysis", &batch);
+        if(thread != nullptr) threads.push_back(thread);
+    }
+    // the main thread works too, so the analysis finishes even if no thread could be started
+    analyzeThread(&batch);
+    for(SDL_Thread* thread : threads)
+        SDL_WaitThread(thread, nullptr);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream file;
+    if(!output_path.empty())
+    {
+        file.open(output_path.c_str(), std::ios::out | std::ios::binary);
+        if(!file.is_open())
+        {
+            std::cerr << "Cannot write " << output_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& output = output_path.empty() ? std::cout : file;
+
+    int failed = 0;
+    for(const Analysis& analysis : batch.levels)
+    {
+        if(analysis.analyzed) writeReport(output, analysis);
+        else
+        {
+            std::cerr << analysis.name << ": not a valid level" << std::endl;
+            failed++;
+        }
+    }
+
+    if(!output_path.empty())
+    {
+        file.close();
+        if(!file)
+        {
+            std::cerr << "Cannot write " << output_path << std::endl;
+            return 1;
+        }
+        std::cout << "Analyzed " << batch.levels.size() - failed << " levels in " << seconds << " s, threads: " << threads.size() + 1 << std::endl;
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/**
+ * Level compiler: converts text levels into the compiled format mapped by @a LevelData::load, or bundles levels into a pack read by @a LevelPack.
+ *
+ * Usage: levelcompiler LEVEL OUTPUT
+ *        levelcompiler --pack PACK LEVEL...
+ *
+ * The compiled level keeps one byte per tile together with spawn points, the position of the eagle and a checksum,
+ * so the game builds the map without parsing text. Levels of a pack may be text or already compiled files; the N-th given level is the stage N, counted from 1.
+ */
+
+#include "../src/level/leveldata.h"
+#include "../src/level/levelpack.h"
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Reading a level and compiling it unless it is already compiled
+ * @param path - path of a text or compiled level
+ * @param data - compiled level
+ * @return @a false if the file could not be read or is not a level; an error is printed
+ */
+static bool readLevel(const std::string& path, std::vector<Uint8>& data)
+{
+    std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+    if(!input.is_open())
+    {
+        std::cerr << "Cannot read " << path << std::endl;
+        return false;
+    }
+    std::ostringstream text;
+    text << input.rdbuf();
+    std::string content = text.str();
+
+    LevelData compiled;
+    if(compiled.attach(reinterpret_cast<const Uint8*>(content.data()), content.size()))
+    {
+        data.assign(content.begin(), content.end());
+        return true;
+    }
+    if(!LevelData::compile(content, data))
+    {
+        std::cerr << path << ": not a rectangular map of at most " << LevelData::max_size << "x" << LevelData::max_size << " characters . # @ % ~ - P E" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc >= 3 && std::string(argv[1]) == "--pack")
+    {
+        if(argc == 3)
+        {
+            std::cerr << "A pack needs at least one level" << std::endl;
+            return 1;
+        }
+        std::vector< std::vector<Uint8> > levels(argc - 3);
+        for(int i = 3; i < argc; i++)
+            if(!readLevel(argv[i], levels[i - 3])) return 1;
+
+        if(!LevelPack::write(argv[2], levels))
+        {
+            std::cerr << "Cannot write " << argv[2] << std::endl;
+            return 1;
+        }
+        std::cout << "Packed " << levels.size() << " levels into " << argv[2] << std::endl;
+        return 0;
+    }
+
+    if(argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " LEVEL OUTPUT" << std::endl;
+        std::cerr << "       " << argv[0] << " --pack PACK LEVEL..." << std::endl;
+        return 1;
+    }
+    std::string level_path = argv[1], output_path = argv[2];
+
+    std::vector<Uint8> data;
+    if(!readLevel(level_path, data)) return 1;
+
+    FILE* output = fopen(output_path.c_str(), "wb");
+    if(output == nullptr)
+    {
+        std::cerr << "Cannot write " << output_path << std::endl;
+        return 1;
+    }
+    bool written = fwrite(data.data(), 1, data.size(), output) == data.size();
+    if(fclose(output) != 0 || !written)
+    {
+        std::cerr << "Cannot write " << output_path << std::endl;
+        return 1;
+    }
+    return 0;
+}
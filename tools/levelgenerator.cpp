@@ -0,0 +1,110 @@
+/**
+ * Level generator: writes seeded random levels in the text format read by the game and by @a levelcompiler.
+ *
+ * Usage: levelgenerator [--size WxH] [--density D] SEED OUTPUT
+ *        levelgenerator --batch COUNT [--size WxH] [--density D] [--seed S] [DIRECTORY]
+ *
+ * The batch mode generates COUNT levels from the seeds S, S+1, ... and prints the number of rejected layouts and the rate of generation,
+ * which is meant for sweeps over the settings; the levels are written to DIRECTORY as S, S+1, ... only if it is given.
+ */
+
+#include "../src/level/levelgenerator.h"
+#include <SDL2/SDL.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * Writing a text level
+ * @param path - path of the file
+ * @param text - content of the level
+ * @return @a false if the file could not be written; an error is printed
+ */
+static bool writeLevel(const std::string& path, const std::string& text)
+{
+    std::ofstream output(path.c_str(), std::ios::out | std::ios::binary);
+    output << text;
+    output.close();
+    if(!output)
+    {
+        std::cerr << "Cannot write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static int usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--size WxH] [--density D] SEED OUTPUT" << std::endl;
+    std::cerr << "       " << name << " --batch COUNT [--size WxH] [--density D] [--seed S] [DIRECTORY]" << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    LevelGenerator::Settings settings;
+    long batch = -1;
+    Uint32 first_seed = 1;
+    std::vector<std::string> positional;
+    for(int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--batch" && i + 1 < argc) batch = atol(argv[++i]);
+        else if(arg == "--seed" && i + 1 < argc) first_seed = strtoul(argv[++i], nullptr, 10);
+        else if(arg == "--density" && i + 1 < argc) settings.density = atof(argv[++i]);
+        else if(arg == "--size" && i + 1 < argc)
+        {
+            if(sscanf(argv[++i], "%dx%d", &settings.width, &settings.height) != 2) return usage(argv[0]);
+        }
+        else if(arg.size() > 1 && arg[0] == '-') return usage(argv[0]);
+        else positional.push_back(arg);
+    }
+
+    if(settings.width < 6 || settings.height < 6 || settings.width > LevelData::max_size || settings.height > LevelData::max_size)
+    {
+        std::cerr << "The size has to be from 6x6 to " << LevelData::max_size << "x" << LevelData::max_size << std::endl;
+        return 1;
+    }
+
+    LevelGenerator generator(settings);
+    std::string text;
+
+    if(batch < 0)
+    {
+        if(positional.size() != 2) return usage(argv[0]);
+        Uint32 seed = strtoul(positional[0].c_str(), nullptr, 10);
+        if(!generator.generate(seed, text))
+        {
+            std::cerr << "No valid level found for the seed " << seed << std::endl;
+            return 1;
+        }
+        return writeLevel(positional[1], text) ? 0 : 1;
+    }
+
+    if(positional.size() > 1) return usage(argv[0]);
+    std::string directory = positional.empty() ? "" : positional[0];
+    if(!directory.empty() && directory[directory.size() - 1] != '/') directory += '/';
+
+    long generated = 0, failed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(long i = 0; i < batch; i++)
+    {
+        Uint32 seed = first_seed + static_cast<Uint32>(i);
+        if(!generator.generate(seed, text))
+        {
+            failed++;
+            continue;
+        }
+        generated++;
+        if(!directory.empty() && !writeLevel(directory + std::to_string(seed), text)) return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Generated " << generated << " levels of " << settings.width << "x" << settings.height << " in " << seconds << " s";
+    if(seconds > 0) std::cout << " (" << static_cast<long>(generated / seconds) << " levels/s)";
+    std::cout << ", rejected layouts: " << generator.rejected() << ", seeds without a level: " << failed << std::endl;
+    return failed == 0 ? 0 : 1;
+}